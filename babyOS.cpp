@@ -3,8 +3,8 @@
 // OS, Fall 2023, Transy U
 //
 //	driver for babyOS that handles error checking for the command line and input file
-//		if both are valid then it will proceed to attempt to schedule and then page the processes
-//  	in the order that they appear in the input file using the indicated algorithms
+//		if both are valid then for FCFS it will proceed to page the processes as they are loaded, in the order that they appear
+//  	in the input file, and then schedule them, for any other scheduler it schedules them first and pages them in the order they ran
 //
 // http://stackoverflow.com/questions/5590381/ddg#5591169
 // https://cplusplus.com/reference/vector/vector/
@@ -13,59 +13,98 @@
 //		the basic resource management of an OS
 //
 //	To use babyOS	enter at the command line --pagerType {pagerType}, --frames #, --framesize #, --pages #,
-//		--schedulerType {schedulerType}, --preemptive, --quanta #, and --verbose to specify options, otherwise the defaults will be used
+//		--schedulerType {schedulerType}, --preemptive, --quanta #, --threads #, and --verbose to specify options, otherwise the defaults will be used
 //		to specify an input file, type the file name as the last argument, otherwise the default will be used
 //	ex. ./babyOS --schedulerType SJF --pagerType LRU --preemptive --pages 10 --verbose file.txt
+//	To convert a text input file to a binary trace (traceFile.h) enter --convert {textFile} followed by the binary file name as the last argument,
+//		the addresses are error checked against --pages and --framesize once here and are not checked again when the binary trace is run
+//	ex. ./babyOS --pages 16 --convert file.txt file.bin
+//		./babyOS --pages 16 --pagerType LRU file.bin
 //	Defaults: schedulerType - FCFS, pagerType - FIFO, frames - 3, pages - 8, framesize - 512, quanta - 10, 
-//		preemptive - false, verbose - false, file - final.in
+//		threads - 1, preemptive - false, verbose - false, file - final.in
+//	With --sweep, --pagerType and --frames may be comma separated lists, every process is paged under each combination
+//		and a matrix of the total page faults is printed instead of paging and scheduling as usual
+//	ex. ./babyOS --sweep --pagerType FIFO,LRU,MFU --frames 1,2,4,8,16 file.txt
+//	With --threads greater than 1 processes are paged in parallel by a PagerPool (pagerPool.h), their output is
+//		still printed in file order so it matches a run with one thread
+//	With --report json or --report csv the usual paging and scheduling output is replaced by a RunReport (report.h) of each process's
+//		page faults, hits, evictions, wait, and turnaround, and the time and peak memory of each phase of the run, errors are still printed
+//	ex. ./babyOS --schedulerType SJF --report json file.txt > metrics.json
+//	--logLevel summary, process, or reference picks how much of the paging is printed (eventLog.h), --verbose being the same as reference,
+//		and --logSample # prints only every #th reference of each process
+//	ex. ./babyOS --logLevel reference --logSample 100 file.txt
+//	Addresses may be up to MAX_ADDRESS_BITS bits wide, the page table (pageTable.h) only grows with the pages that are touched so --pages
+//		can describe a whole 48-bit address space, and --tlb-entries # with --tlb-ways # puts a set associative TLB in front of it
+//		whose hit rate is printed with each process's page faults, without --tlb-ways the TLB is fully associative
+//	ex. ./babyOS --pages 68719476736 --framesize 4096 --tlb-entries 64 --tlb-ways 4 file.txt
+//	With --global-frames every process competes for one pool of --frames frames (globalPager.h) rather than each getting --frames of its own,
+//		so the processes are always paged in the order they were scheduled, FCFS included, and each reports the frames it stole from the others
+//	ex. ./babyOS --global-frames --frames 16 --schedulerType RR --preemptive --quanta 5 file.txt
+//	--pagerType OPT pages with Belady's optimal policy as a lower bound for the others, WSClock and PFF take --window # references as their
+//		working set window, PFF resizing each process's resident set as it runs with --frames as its limit
+//	ex. ./babyOS --sweep --pagerType OPT,LRU,WSClock,PFF --window 32 --frames 4,8,16 file.txt
+//	--batch {jobFile} runs many configurations in one invocation (batchRunner.h), each line of jobFile holds the options and file of one run
+//		as they would be typed after ./babyOS, the jobs run on --threads # threads, and each one prints a single line of JSON results
+//		--batch - reads the jobs from standard input instead, a trace used by more than one job is only read in once
+//	ex. ./babyOS --batch jobs.txt --threads 8 > results.jsonl
+//	--checkpoint {snapshotFile} saves the whole run, the scheduler's clock and queues, each process's place in its addresses, and every
+//		pager's frames and page table, to snapshotFile every --checkpointEvery # references (checkpoint.h), and --resume {snapshotFile}
+//		picks a run up from one. A snapshot can be resumed under another --schedulerType to try it from the same warmed up state
+//	ex. ./babyOS --checkpoint run.snap --checkpointEvery 100000000 --pages 4096 big.bin
+//		./babyOS --resume run.snap --checkpoint run.snap --pages 4096 big.bin
+//		./babyOS --resume run.snap --schedulerType SJF --pages 4096 big.bin
+//	--pipeline parses a text input file on a thread of its own while FCFS or --sweep pages the processes already parsed (tracePipeline.h),
+//		which overlaps reading the file with paging it, the output is the same as without it
+//	ex. ./babyOS --pipeline --pages 256 --frames 16 big.in
+//	--profile prints how many times each stage of the run was entered and the cycles spent in it once the run is done (profiler.h), loading,
+//		scheduling, and paging, and within them address checks, page table lookups, and picking victims, --perf-events adds the cache and
+//		branch misses of loading, scheduling, and paging from Linux perf_event counters. Built with make PROFILE_FLAGS=-DNO_PROFILE the
+//		counters are compiled out and --profile is an error
+//	ex. ./babyOS --profile --perf-events --schedulerType SJF --pagerType LRU --pages 256 big.bin
 //
-// The CPU scheduler we recieved would eventually core dump on all algorithms except for FCFS and RR
-// 	as such we believed it to be safer to comment out those function calls and print out that those schedulers are unsafe and that FCFS should be used
-// RR was fully commented out and so we print out a statement saying that it has yet to be implemented 
-// FCFS runs fully without core dumping, however it nearly always returns a wrong answer for average wait time
-// 	Since FCFS doesn't core dump we decided to leave it in and print out a message that warns that the average wait time may be incorrect
-// 	Also to use FCFS, since it takes in a file name, we had to write the processes without their addresses to a new file and pass it in
-// 	Thankfully, we knew the formatting of a file for the CPU scheduler since we worked on one as well
-//	With this solution, we have to have an additional error check for if the specified file at the command line matches the one defined by CPU_FILE
-//	If it does, we print out a message that that file name is reserved for the babyOS's G4CPU
-// For SJF and Priority we did not intend on using the CPU Scheduler function putQueue since there were no comments on it
-// 	and its absence seemed to have no effect on the runnability of the scheduler, with or without the function it core dumps
-//	When we tested it, we figured that the count could be the number of processes since it'd print out a process block as many times as the count
-//	Even passing in a count with this in mind, it did not prevent a core dump
-// We cannot have the pager page the processes in the order they were scheduled because only one scheduler works and for the one that does
-//	work there is no way we can access the scheduled process order. Additionally, we believed it would go against the idea of trying to integrate
-//	G4CPU as we'd be writing our own scheduler and doing their job for them
+// The CPU scheduler we recieved would eventually core dump on all algorithms except for FCFS and RR, and RR was fully commented out
+//	so for a long time babyOS printed that those schedulers were unsafe and that FCFS should be used
+// SJF, Priority, and RR are now scheduled by babyOS's own Scheduler (scheduler.h), which runs on the process table in memory and returns
+//	the order the processes ran in, so the pager can finally page them in the order they were scheduled rather than in file order
+//	Each slice of the timeline pages that many of the process's addresses, one per time unit, so processes are paged interleaved
+//	Since that needs every process's addresses at once, a text input file is read in whole for these schedulers
+// FCFS ran fully without core dumping, however it nearly always returned a wrong answer for average wait time, and since it took in a file name
+//	we had to write the processes without their addresses to a reserved file, CPU_FILE, and have it parse them all over again
+//	FCFS is now scheduled by the same Scheduler straight from the process table the loader builds, so there is no temporary file, no second parse,
+//	no reserved file name, and any number of babyOS runs can share a working directory
+//	FCFS still pages as the file is streamed in, in file order, and is scheduled afterwards from the headers of the processes alone
 // 
-// The pager we recieved was fully operational
+// The pager we recieved was fully operational, but it could only report through cout and had to be redeclared for every process,
+//	so processes are now paged by babyOS's own PagerEngine (pagerEngine.h) which implements the same policies
 // We did not include symConsts.h in our driver because we wanted all the definitions that it needs
 // 	to be in one place: the header associated with the driver
 // We also changed the option for the random pagerType to be "Random" instead of "RANDOM" to be in line with how it is defined
 //	in symConsts.h so that the random pager would work
-// We decided that in our for loop that calls the pager function that we would have PageTable and PageReplacementSimulator
-//	be redeclared with each iteration of the loop in order to reset pageFaultCount and the pageTable for the next process.
-//	If we don't redeclare the PageTable then the pager will core dump with multiple processes and if we don't redeclare
-//	PageReplacementSimulator then each processes's total will actually be a running total
-//	ex. P1 faults = 5, P2 faults = 14, P2 itself only had 9 faults, 14 is the running total
-//	we think this is likely because the creators of the pager dealt with only one process and so felt no need
-//	to reset the pageTable or the pagefaultCount
-// We think it'd be better to have the individual totals be correct with no running total than incorrect with a running total 
-// We can't get the cumulative total of page faults as we cannot access pageFaultCount since it is a private variable
-// We didn't use updateFreeFrame or updateVictimFrame because it was clear that they were meant for use by the pager itself and not to be
-//	called explicitly by the driver
+// We used to redeclare the G5Pager's PageTable and PageReplacementSimulator for every process so that each process's page faults
+//	were its own total rather than a running total, a single PagerEngine is now reset between processes to the same effect
+// The input file is streamed in through TraceLoader (traceLoader.h) rather than read into a vector of every process up front,
+//	each process is paged as soon as it has been error checked and then discarded, so memory no longer grows with the size of the file.
+//	As a result an error late in the file is only reported after the processes before it have been paged
 //
 // The files our group specifically made were: babyOS.cpp, babyOS.h, and the makefile. All others were made by the other two groups.
 //
 
 //#include "symConsts.h"
-#include "FCFS.h"
-#include "pageReplacementSimulator.h"
-#include "pageTable.h"
-#include "Priority.h"
-#include "procManagement.h" 
-#include "RoundRobin.h"
-#include "SJF.h"
+#include "batchRunner.h"
+#include "checkpoint.h"
+#include "pagerEngine.h"
+#include "pagerPool.h"
+#include "pagerSweep.h"
+#include "profiler.h"
+#include "report.h"
+#include "scheduler.h"
+#include "traceFile.h"
+#include "traceLoader.h"
+#include "tracePipeline.h"
 
 #include "babyOS.h"
+#include "eventLog.h"
+#include "inputParse.h"
 #include <iostream>
 #include <fstream>
 #include <cstring>
@@ -75,16 +114,241 @@
 using namespace std;
 
 int main(int argc, char **argv){
-  bool flags[MAX_FLAGS];
-  char pagerType[INPUT_MAX], frames[INPUT_MAX], pages[INPUT_MAX], frameSize[INPUT_MAX];
-  char schedulerType[INPUT_MAX], quanta[INPUT_MAX], fileName[INPUT_MAX];
-  vector<PCB> processes;
-  queue<PCB>  addressQueue;
+  RunOptions options;
+  bool binaryTrace;
+  TraceLoader loader;
+  MappedTrace mappedTrace;
+  RunReport report;
+  
+  report.begin(PARSE_PHASE);
+  if(!parseOptions(argc, argv, options)) exit(1);
+  // the rest of the run reads the options through their usual names
+  char *pagerType = options.pagerType, *frames = options.frames, *pages = options.pages, *frameSize = options.frameSize;
+  char *schedulerType = options.schedulerType, *quanta = options.quanta, *fileName = options.fileName, *convertFile = options.convertFile;
+  char *threads = options.threads, *reportFormat = options.reportFormat, *logLevel = options.logLevel, *logSample = options.logSample;
+  char *tlbEntries = options.tlbEntries, *tlbWays = options.tlbWays, *window = options.window;
+  char *checkpointFile = options.checkpointFile, *checkpointEvery = options.checkpointEvery, *resumeFile = options.resumeFile;
+  bool *flags = options.flags;
+  
+  int frameInt = atoi(frames);
+  long long pageInt = atoll(pages);
+  int frameSizeInt = atoi(frameSize);
+  int threadInt = atoi(threads);
+  int pageShift = 0;
+  while((1 << pageShift) < frameSizeInt) pageShift++;
+  LogLevel level = flags[VERBOSE_FLAG] ? REFERENCE_LOG : logLevelFromName(logLevel);
+  int sampleInt = atoi(logSample);
+  int tlbEntryInt = atoi(tlbEntries);
+  int tlbWayInt = flags[TLB_WAYS_FLAG] ? atoi(tlbWays) : tlbEntryInt;
+  int windowInt = atoi(window);
+  report.end(PARSE_PHASE);
+  // --profile starts counting before anything is loaded, it prints nothing until the run has finished
+  if(flags[PROFILE_FLAG] && !startProfile(flags[PERF_EVENTS_FLAG])) exit(1);
+  
+  // with --report the paging and scheduling output goes nowhere and only the report is printed, errors still go to cout
+  ostream noOutput(NULL);
+  ostream &console = flags[REPORT_FLAG] ? noOutput : cout;
+  vector<PagerStats> pagerStats;
+  vector<pair<string, string>> configuration = runConfiguration(options);
+  
+  // a batch runs every job in its job file, or in standard input for BATCH_STDIN, and prints a line of results for each one
+  if(flags[BATCH_FLAG]){
+    BatchRunner batch(threadInt, cout.rdbuf());
+    if(!strcmp(options.batchFile, BATCH_STDIN)) return batch.run(cin) ? 0 : 1;
+    ifstream jobs(options.batchFile);
+    if(!jobs){
+      cout << "\tERROR: File not opened\n";
+      exit(1);
+    }
+    return batch.run(jobs) ? 0 : 1;
+  }
+  
+  // converting writes the error checked text file convertFile out as a binary trace named by the file argument and does nothing else
+  if(flags[CONVERT_FLAG]){
+    if(!options.fileGiven){
+      cout << "\tERROR: " << CONVERT << " requires an output file name as the last argument\n";
+      exit(1);
+    }
+    if(!strcmp(convertFile,fileName)){
+      cout << "\tERROR: " << CONVERT << " cannot overwrite its own input file\n";
+      exit(1);
+    }
+    cout << "\nConverting \"" << convertFile << "\" to \"" << fileName << "\"...\n";
+    if(!convertTrace(convertFile, fileName, frameSizeInt, pageInt)) exit(1);
+    cout << "Conversion successful!\n\n";
+    if(flags[PROFILE_FLAG]) printProfile(cout);
+    return 0;
+  }
+  
+  // a binary trace was already error checked when it was converted, so it is mapped instead of parsed
+  report.begin(LOAD_PHASE);
+  binaryTrace = isTraceFile(fileName);
+  if(binaryTrace){
+    if(!mappedTrace.open(fileName, frameSizeInt, pageInt)) exit(1);
+  }
+  else if(!loader.open(fileName)){
+    cout << "\tERROR: File not opened\n";
+    exit(1);
+  }
+  report.end(LOAD_PHASE);
+  
+  // with --pipeline the sweep and FCFS take a text input file's processes from a TracePipeline (tracePipeline.h), which parses them on a
+  // thread of its own while the ones before them are paged, a binary trace has nothing to parse and is always read straight from its mapping
+  TracePipeline *pipeline = NULL;
+  auto nextProcess = [&](PCB &block){
+    if(binaryTrace) return mappedTrace.nextProcess(block);
+    if(pipeline) return pipeline->nextProcess(block);
+    return loader.nextProcess(block, frameSizeInt, pageInt);
+  };
+  
+  // a sweep pages every process under each pager type and frame count listed and prints the page fault totals instead of paging and scheduling
+  if(flags[SWEEP_FLAG]){
+    vector<string_view> typeList = splitList(pagerType), frameList = splitList(frames);
+    vector<PagerPolicy> policies;
+    vector<int> frameCounts(frameList.size());
+    for(size_t i=0;i<typeList.size();i++) policies.push_back(policyFromName(typeList[i]));
+    for(size_t i=0;i<frameList.size();i++) parseInteger(frameList[i], frameCounts[i]);
+    
+    PagerSweep sweep(policies, frameCounts, pageInt, windowInt);
+    PCB block;
+    cout << "\nProcesses sweeping...\n";
+    if(flags[PIPELINE_FLAG] && !binaryTrace) pipeline = new TracePipeline(loader, frameSizeInt, pageInt);
+    while(nextProcess(block)){
+      sweep.pageProcess(block.addresses, block.burst, pageShift);
+    }
+    delete pipeline;
+    if(loader.failed()) exit(1);
+    sweep.print(cout);
+    cout << "Sweep successful!\n\n";
+    if(flags[PROFILE_FLAG]) printProfile(cout);
+    return 0;
+  }
+  
+  // SJF, Priority, and RR are scheduled first and the processes are then paged in the order they ran, interleaved a slice at a time,
+  // which needs every process's addresses at once, a binary trace already has them mapped and a text one is read in whole
+  // with --global-frames FCFS is too, since what one process leaves in the shared frames depends on what ran before it,
+  // and with --checkpoint or --resume, which save and restore the run at a time on its timeline
+  SchedulerPolicy schedulerPolicy = schedulerFromName(schedulerType);
+  if(schedulerPolicy != FCFS_SCHEDULER || flags[GLOBAL_FLAG] || flags[CHECKPOINT_FLAG] || flags[RESUME_FLAG]){
+    ProcessTable processTable;
+    report.begin(LOAD_PHASE);
+    if(binaryTrace) mappedTrace.fillTable(processTable);
+    else if(!readTrace(loader, frameSizeInt, pageInt, processTable)) exit(1);
+    report.end(LOAD_PHASE);
+    
+    Scheduler scheduler(schedulerPolicy, flags[PREEMPTIVE_FLAG], atoi(quanta));
+    Checkpointer *checkpointer = NULL;
+    if(flags[CHECKPOINT_FLAG] || flags[RESUME_FLAG]){
+      SnapshotHeader header = snapshotHeader(policyFromName(pagerType), frameInt, pageInt, windowInt, tlbEntryInt, tlbWayInt, pageShift,
+                                             flags[GLOBAL_FLAG], processTable);
+      checkpointer = new Checkpointer(flags[CHECKPOINT_FLAG] ? checkpointFile : NULL, atoll(checkpointEvery), header, scheduler, processTable);
+      if(flags[RESUME_FLAG] && !checkpointer->resume(resumeFile, scheduler)) exit(1);
+    }
+    
+    vector<ScheduleSlice> timeline;
+    console << "\nProcesses scheduling...\n\n";
+    report.begin(SCHEDULE_PHASE);
+    // a resumed run only schedules and pages what was left when its snapshot was taken
+    if(checkpointer && checkpointer->resuming()){
+      console << "\tResuming \"" << resumeFile << "\" at time " << checkpointer->resumedTime() << " after " << checkpointer->resumedPaged() << " references\n";
+      scheduler.run(timeline);
+    }
+    else scheduler.schedule(processTable, timeline);
+    scheduler.print(processTable, timeline, console);
+    report.end(SCHEDULE_PHASE);
+    console << "Scheduling successful!\n";
+    
+    console << "\nProcesses paging...\n";
+    EventLog log(level, sampleInt, console);
+    report.begin(PAGE_PHASE);
+    bool paged;
+    if(flags[GLOBAL_FLAG]) paged = pageScheduleGlobal(timeline, processTable, policyFromName(pagerType), frameInt, pageInt, windowInt, pageShift, log, pagerStats, checkpointer);
+    else paged = pageSchedule(timeline, processTable, policyFromName(pagerType), frameInt, pageInt, windowInt, tlbEntryInt, tlbWayInt, pageShift, log, pagerStats, checkpointer);
+    log.flush();
+    if(!paged) exit(1);
+    report.end(PAGE_PHASE);
+    delete checkpointer;
+    console << "\n\tPlease note that processes are paged in the order in which they were scheduled\n";
+    console << "Paging successful!\n\n";
+    
+    if(flags[REPORT_FLAG]){
+      report.collect(processTable, pagerStats, scheduler.wait, scheduler.turnaround);
+      report.write(cout, reportFormat, configuration);
+    }
+    if(flags[PROFILE_FLAG]) printProfile(console);
+    return 0;
+  }
+  
+  // each process is paged as soon as the loader has error checked it so that only one process's addresses are held at a time
+  // only its header is kept, in the process table that FCFS is scheduled from afterwards
+  // loading and paging take turns, so each phase is timed around every call and adds up over the whole file
+  // with --pipeline they overlap instead and the load phase is only the time paging spent waiting on the parser thread
+  ProcessTable processTable;
+  PCB block;
+  PagerPool *pool = NULL;
+  PagerEngine engine(policyFromName(pagerType), frameInt, pageInt, windowInt, tlbEntryInt, tlbWayInt);
+  EventLog log(level, sampleInt, console);
+  bool loaded;
+  console << "\nProcesses paging...\n";
+  if(threadInt > 1) pool = new PagerPool(threadInt, frameInt, pageInt, windowInt, tlbEntryInt, tlbWayInt, pageShift, level, sampleInt, pagerType, console, pagerStats);
+  // the pipeline is started after the pool so that the parser thread's errors are captured into the pool's output in order
+  if(flags[PIPELINE_FLAG] && !binaryTrace) pipeline = new TracePipeline(loader, frameSizeInt, pageInt);
+  while(true){
+    report.begin(LOAD_PHASE);
+    loaded = nextProcess(block);
+    report.end(LOAD_PHASE);
+    if(!loaded) break;
+    processTable.push(block, false);
+    
+    // with more than one thread the process is handed to the pool, which prints its output once the processes before it have printed theirs
+    report.begin(PAGE_PHASE);
+    if(pool) pool->submit(block);
+    else{
+      pagerStats.push_back(pageProcess(engine, block.pid, block.addresses, block.burst, pageShift, log));
+      // the loader prints its errors straight to cout, so the log can't hold a process's output past the next load
+      log.flush();
+    }
+    report.end(PAGE_PHASE);
+  }
+  delete pipeline;
+  if(pool){
+    report.begin(PAGE_PHASE);
+    pool->finish();
+    report.end(PAGE_PHASE);
+    delete pool;
+  }
+  loader.close();
+  mappedTrace.close();
+  if(loader.failed()) exit(1);
+  console << "\n\tPlease note that processes are paged in the order in which they appear in \"" << fileName << "\"\n";
+  console << "Paging successful!\n";
+  
+  Scheduler scheduler(FCFS_SCHEDULER, false, 0);
+  vector<ScheduleSlice> timeline;
+  console << "\nProcesses scheduling...\n\n";
+  report.begin(SCHEDULE_PHASE);
+  scheduler.schedule(processTable, timeline);
+  scheduler.print(processTable, timeline, console);
+  report.end(SCHEDULE_PHASE);
+  console << "Scheduling successful!\n";
+  
+  console << "\n";
+  if(flags[REPORT_FLAG]){
+    report.collect(processTable, pagerStats, scheduler.wait, scheduler.turnaround);
+    report.write(cout, reportFormat, configuration);
+  }
+  if(flags[PROFILE_FLAG]) printProfile(console);
+  return 0;
+}
+
+bool parseOptions(int argc, char **argv, RunOptions &options){
+  char *pagerType = options.pagerType, *frames = options.frames, *pages = options.pages, *frameSize = options.frameSize;
+  char *schedulerType = options.schedulerType, *quanta = options.quanta, *fileName = options.fileName, *convertFile = options.convertFile;
+  char *threads = options.threads, *reportFormat = options.reportFormat, *logLevel = options.logLevel, *logSample = options.logSample;
+  char *tlbEntries = options.tlbEntries, *tlbWays = options.tlbWays, *window = options.window, *batchFile = options.batchFile;
+  char *checkpointFile = options.checkpointFile, *checkpointEvery = options.checkpointEvery, *resumeFile = options.resumeFile;
+  bool *flags = options.flags;
   int fileIndex;
-  ifstream inputFile;
-  FCFS fcfs;
-  // Priority pri;
-  // SJF sjf;
   
   // ensures a default is present in case a value is not specified
   strcpy(pagerType,DEFAULT_PAGER_TYPE);
@@ -94,28 +358,47 @@ int main(int argc, char **argv){
   strcpy(pages,DEFAULT_PAGES);
   strcpy(quanta,DEFAULT_QUANTA);
   strcpy(fileName,DEFAULT_FILE);
+  strcpy(threads,DEFAULT_THREADS);
+  strcpy(reportFormat,"");
+  strcpy(logLevel,DEFAULT_LOG_LEVEL);
+  strcpy(logSample,DEFAULT_LOG_SAMPLE);
+  strcpy(tlbEntries,DEFAULT_TLB_ENTRIES);
+  strcpy(tlbWays,"");
+  strcpy(window,DEFAULT_WINDOW);
+  strcpy(batchFile,"");
+  strcpy(checkpointFile,"");
+  strcpy(checkpointEvery,DEFAULT_CHECKPOINT_EVERY);
+  strcpy(resumeFile,"");
 
   for(int i=0;i<MAX_FLAGS;i++) flags[i]=false;
   
+  // every value is copied into one of the INPUT_MAX byte buffers of options, and a batch job's come from a file or standard input
+  // rather than a shell, so an argument too long to fit is refused before anything is copied
+  for(int i=1;i<argc;i++){
+    if(strlen(argv[i]) >= INPUT_MAX){
+      cout << "\tERROR: " << string_view(argv[i], INPUT_ARGUMENT_SHOWN) << "... is longer than the " << INPUT_MAX - 1 << " characters an option or file name may be\n";
+      return false;
+    }
+  }
+  
   // if fileIndex is -1, an error has occurred
   // if fileIndex is 0 then the default will be used
   // otherwise the file has been specified and will be used
   fileIndex = commandErrorCheck(argc, argv);
   if(fileIndex == -1){
-    exit(1);
+    return false;
   }
   else if(fileIndex){
     strcpy(fileName,argv[fileIndex]);
   }
-  if(!strcmp(fileName,CPU_FILE)){
-    cout << "\tApologies, this file name is reserved for babyOS's CPU Scheduler. Please use a different one.\n";
-    exit(1);
-  }
+  options.fileGiven = fileIndex != 0;
   
   // counts of how many times each option is entered and index of a repeat
   int repeatIndex = 0;
   int pagerTypeOptions=0,pageOptions=0,frameOptions=0,sizeOptions=0;
-  int schedulerTypeOptions=0,preemptiveOptions=0,quantaOptions=0,verboseOptions=0;
+  int schedulerTypeOptions=0,preemptiveOptions=0,quantaOptions=0,verboseOptions=0,convertOptions=0,threadOptions=0,sweepOptions=0,reportOptions=0;
+  int logLevelOptions=0,logSampleOptions=0,tlbEntryOptions=0,tlbWayOptions=0,globalOptions=0,windowOptions=0,batchOptions=0;
+  int checkpointOptions=0,checkpointEveryOptions=0,resumeOptions=0,pipelineOptions=0,profileOptions=0,perfEventOptions=0;
   
   // stores the value of each specified argument so that it can be used in page replacement and cpu scheduling
   // if any repeats are found, then it will gracefully exit
@@ -153,216 +436,243 @@ int main(int argc, char **argv){
       verboseOptions>=1 ? repeatIndex=i : verboseOptions++;
       flags[VERBOSE_FLAG] = true;
     }
+    else if(!strcmp(argv[i],CONVERT)){
+      convertOptions>=1 ? repeatIndex=i : convertOptions++;
+      strcpy(convertFile,argv[i+1]);
+      flags[CONVERT_FLAG] = true;
+    }
+    else if(!strcmp(argv[i],THREADS)){
+      threadOptions>=1 ? repeatIndex=i : threadOptions++;
+      strcpy(threads,argv[i+1]);
+    }
+    else if(!strcmp(argv[i],SWEEP)){
+      sweepOptions>=1 ? repeatIndex=i : sweepOptions++;
+      flags[SWEEP_FLAG] = true;
+    }
+    else if(!strcmp(argv[i],REPORT)){
+      reportOptions>=1 ? repeatIndex=i : reportOptions++;
+      strcpy(reportFormat,argv[i+1]);
+      flags[REPORT_FLAG] = true;
+    }
+    else if(!strcmp(argv[i],LOG_LEVEL)){
+      logLevelOptions>=1 ? repeatIndex=i : logLevelOptions++;
+      strcpy(logLevel,argv[i+1]);
+      flags[LOG_LEVEL_FLAG] = true;
+    }
+    else if(!strcmp(argv[i],LOG_SAMPLE)){
+      logSampleOptions>=1 ? repeatIndex=i : logSampleOptions++;
+      strcpy(logSample,argv[i+1]);
+    }
+    else if(!strcmp(argv[i],TLB_ENTRIES)){
+      tlbEntryOptions>=1 ? repeatIndex=i : tlbEntryOptions++;
+      strcpy(tlbEntries,argv[i+1]);
+    }
+    else if(!strcmp(argv[i],TLB_WAYS)){
+      tlbWayOptions>=1 ? repeatIndex=i : tlbWayOptions++;
+      strcpy(tlbWays,argv[i+1]);
+      flags[TLB_WAYS_FLAG] = true;
+    }
+    else if(!strcmp(argv[i],GLOBAL_FRAMES)){
+      globalOptions>=1 ? repeatIndex=i : globalOptions++;
+      flags[GLOBAL_FLAG] = true;
+    }
+    else if(!strcmp(argv[i],WINDOW)){
+      windowOptions>=1 ? repeatIndex=i : windowOptions++;
+      strcpy(window,argv[i+1]);
+      flags[WINDOW_FLAG] = true;
+    }
+    else if(!strcmp(argv[i],BATCH)){
+      batchOptions>=1 ? repeatIndex=i : batchOptions++;
+      strcpy(batchFile,argv[i+1]);
+      flags[BATCH_FLAG] = true;
+    }
+    else if(!strcmp(argv[i],CHECKPOINT)){
+      checkpointOptions>=1 ? repeatIndex=i : checkpointOptions++;
+      strcpy(checkpointFile,argv[i+1]);
+      flags[CHECKPOINT_FLAG] = true;
+    }
+    else if(!strcmp(argv[i],CHECKPOINT_EVERY)){
+      checkpointEveryOptions>=1 ? repeatIndex=i : checkpointEveryOptions++;
+      strcpy(checkpointEvery,argv[i+1]);
+      flags[CHECKPOINT_EVERY_FLAG] = true;
+    }
+    else if(!strcmp(argv[i],RESUME)){
+      resumeOptions>=1 ? repeatIndex=i : resumeOptions++;
+      strcpy(resumeFile,argv[i+1]);
+      flags[RESUME_FLAG] = true;
+    }
+    else if(!strcmp(argv[i],PIPELINE)){
+      pipelineOptions>=1 ? repeatIndex=i : pipelineOptions++;
+      flags[PIPELINE_FLAG] = true;
+    }
+    else if(!strcmp(argv[i],PROFILE)){
+      profileOptions>=1 ? repeatIndex=i : profileOptions++;
+      flags[PROFILE_FLAG] = true;
+    }
+    else if(!strcmp(argv[i],PERF_EVENTS)){
+      perfEventOptions>=1 ? repeatIndex=i : perfEventOptions++;
+      flags[PERF_EVENTS_FLAG] = true;
+    }
     // if a repeat is found, its index will be saved
     // since repeatIndex will change from 0, it will evaluate as true
     if(repeatIndex){
       cout << "\tERROR: " << argv[i] << " has been entered multiple times\n";
-      exit(1);
+      return false;
     }
   }
   
-  // makes sure that input numbers and flags are valid, if not we gracefully exit
-  if(inputErrorCheck(pages,frames,frameSize,schedulerType,quanta,flags)) exit(1);
-  
-  inputFile.open(fileName);
-  if(!inputFile){
-    cout << "\tERROR: File not opened\n";
-    exit(1);
+  // every other option of a batch comes from its job file
+  if(flags[BATCH_FLAG] && (fileIndex || argc - 1 != 2 * (batchOptions + threadOptions))){
+    cout << "\tERROR: " << BATCH << " takes every other option from its job file and can only be combined with " << THREADS << "\n";
+    return false;
   }
   
-  PCB block;
-  string fileInput,arrival,burst,priority;
-  bool sameProcess;
-  
-  inputFile >> fileInput;
-  while(!inputFile.eof()){
-    if(idErrorCheck(fileInput)) exit(1);
-    block.pid = atoi(fileInput.substr(2,fileInput.length()).c_str());
-    
-    inputFile >> arrival;
-    inputFile >> burst;
-    inputFile >> priority;
-    if(loadErrorCheck(block.pid,arrival,burst,priority)) exit(1);
-    block.arrival = atoi(arrival.c_str());
-    block.burst = atoi(burst.c_str());
-    block.priority = atoi(priority.c_str());
-    
-    sameProcess = true;
-    inputFile >> fileInput;
-    for(int i=0;i<block.burst;i++){
-      // if a pid is seen when trying to read in addresses, stop pushing to the address queue
-      if(fileInput.find(PID_FORM)!=string::npos) sameProcess=false;
-      if(!inputFile.eof() && sameProcess){
-        if(addressErrorCheck(block.pid,atoi(frameSize),atoi(pages),fileInput)) exit(1);
-        block.addresses.push(atoi(fileInput.c_str()));
-        inputFile >> fileInput;
-      }
-    }
-    if(block.burst!=block.addresses.size() || (!inputFile.eof() && fileInput.find(PID_FORM)==string::npos)){
-      cout << "\tERROR: " << PID_FORM << block.pid << " must have a number of memory addresses equivalent to its burst time [1 address: 1 time unit]\n";
-      exit(1);
-    }
-    
-    processes.push_back(block);
-    // will clear block's queue of addresses to prepare for next process
-    while (!block.addresses.empty()) block.addresses.pop();
+  // makes sure that input numbers and flags are valid
+  return !inputErrorCheck(pagerType,pages,frames,frameSize,schedulerType,quanta,threads,reportFormat,logLevel,logSample,tlbEntries,tlbWays,window,checkpointEvery,flags);
+}
+
+vector<pair<string, string>> runConfiguration(const RunOptions &options){
+  return {{"pagerType", options.pagerType}, {"frames", options.frames}, {"framesize", options.frameSize}, {"pages", options.pages},
+    {"schedulerType", options.schedulerType}, {"preemptive", options.flags[PREEMPTIVE_FLAG] ? "true" : "false"}, {"quanta", options.quanta},
+    {"threads", options.threads}, {"file", options.fileName}};
+}
+
+bool inputErrorCheck(string pagerType, string pages, string frames, string frameSize, string schedulerType, string quanta, string threads, string reportFormat, string logLevel, string logSample, string tlbEntries, string tlbWays, string window, string checkpointEvery, bool *flags){
+  bool error = false;
+  if(!strcmp(schedulerType.c_str(),FIRST_COME_FIRST_SERVE) && flags[PREEMPTIVE_FLAG]){
+    cout << "\tERROR: FCFS cannot be preemptive\n";
+    error = true;
   }
-  inputFile.close();
-  
-  // writes processes to a separate file without their addresses
-  ofstream processesFile(CPU_FILE);
-  for(int i = 0; i < processes.size(); i++) {
-    processesFile << "P_" << processes.at(i).pid << " "
-		  << processes.at(i).arrival << " "
-		  << processes.at(i).burst << " "
-		  << processes.at(i).priority << endl;
-  }
-  processesFile.close();
-  
-  // FCFS gives erroneous answers
-  cout << "\nProcesses scheduling...\n\n";
-  if (strcmp(schedulerType, FIRST_COME_FIRST_SERVE) == 0) {
-    fcfs.loadProcessesFromFile(CPU_FILE);
-    fcfs.execute(flags[VERBOSE_FLAG]);
-    cout << "\tPlease be aware average wait does not seem to be correct most of the time.\n";
-    cout << "Scheduling successful!\n";
-  }
-  // this will run partially and then core dump, so we commented it out
-  else if (strcmp(schedulerType, SHORTEST_JOB_FIRST) == 0) {
-    if (flags[PREEMPTIVE_FLAG]) {
-      // sjf.putQueue(CPU_FILE,4,true);
-      // sjf.loadProcessesFromFile(CPU_FILE, true);
-      // sjf.executePremtion();
-      cout << "\tUnfortunately Baby OS will core dump if preemptive SJF is used. Please use FCFS.\n";
+  if(!strcmp(schedulerType.c_str(),ROUND_ROBIN) && !flags[PREEMPTIVE_FLAG]){
+    cout << "\tERROR: RR must be preemptive\n";
+    error = true;
+  }
+  if(strcmp(schedulerType.c_str(),ROUND_ROBIN) && flags[QUANTA_FLAG]){
+    cout << "\tERROR: Only RR should have a quanta specification\n";
+    error = true;
+  }
+  if(flags[QUANTA_FLAG] && (!integerCheck(quanta) || (atoi(quanta.c_str()) <= 0))){
+    cout << "\tERROR: Quanta must be a positive integer\n";
+    error = true;
+  }
+  long long pageCount;
+  if(parseInteger(pages, pageCount) != PARSE_OK || pageCount <= 0){
+    cout << "\tERROR: Pages must be a positive integer\n";
+    error = true;
+  }
+  else if(integerCheck(frameSize) && atoi(frameSize.c_str()) > 0 && pageCount > (1LL << MAX_ADDRESS_BITS) / atoi(frameSize.c_str())){
+    cout << "\tERROR: " << pages << " pages of " << frameSize << " bytes cover more than a " << MAX_ADDRESS_BITS << "-bit address space\n";
+    error = true;
+  }
+  // with --sweep frames is a list of frame counts, otherwise it is a list of just one
+  vector<string_view> frameCounts = splitList(frames);
+  if(!flags[SWEEP_FLAG] && (frameCounts.size() > 1 || splitList(pagerType).size() > 1)){
+    cout << "\tERROR: Only " << SWEEP << " can be given lists of pager types or frames\n";
+    error = true;
+  }
+  for(size_t i=0;i<frameCounts.size();i++){
+    int frameCount;
+    if(parseInteger(frameCounts[i], frameCount) != PARSE_OK || frameCount <= 0 || frameCount > MAX_FRAMES){
+      cout << "\tERROR: Frames must be a positive integer between 1 and " << MAX_FRAMES << "\n";
+      error = true;
+      break;
     }
-    else{
-      // sjf.putQueue(CPU_FILE,4,false);
-      // sjf.loadProcessesFromFile(CPU_FILE, false);
-      // sjf.execute();
-      cout << "\tUnfortunately Baby OS will core dump if nonpreemptive SJF is used. Please use FCFS.\n";
-    }
-    cout << "Scheduling failed.\n";
-  }
-  // this will run partially and then core dump, so we commented it out
-  else if (strcmp(schedulerType, PRIORITY) == 0) {
-    if (flags[PREEMPTIVE_FLAG]) {
-      // pri.putQueue(CPU_FILE,4,true);
-      // pri.loadProcessesFromFile(CPU_FILE, true);
-      // pri.executePremtion();
-      cout << "\tUnfortunately Baby OS will core dump if preemptive Priority is used. Please use FCFS.\n";
-    }
-    else {
-      // pri.putQueue(CPU_FILE,4,false);
-      // pri.loadProcessesFromFile(CPU_FILE, false);
-      // pri.execute();
-      cout << "\tUnfortunately Baby OS will core dump if nonpreemptive Priority is used. Please use FCFS.\n";
-    }
-    cout << "Scheduling failed.\n";
-  } 
-  // round robin was entirely commented out in the header, so we couldn't implement it
-  else if (strcmp(schedulerType, ROUND_ROBIN) == 0) {
-    cout << "\tUnfortunately Baby OS does not have RR implemented yet. Please use FCFS.\n";
-    cout << "Scheduling failed.\n";
   }
-  
-  cout << "Processes paging...\n";
-  if (strcmp(pagerType, FIRST_IN_FIRST_OUT) == 0 ||
-      strcmp(pagerType, LEAST_RECENT_USED) == 0 ||
-      strcmp(pagerType, MOST_FREQUENT_USED) == 0 ||
-      strcmp(pagerType, RANDOM) == 0) {
-    
-    int frameInt = atoi(frames);  
-    int pageInt = atoi(pages);    
-    int frameSizeInt = atoi(frameSize); 
-    string pid;
-    for (int i = 0; i < processes.size(); i++) {
-      // redeclare the PageTable and PageReplacementSimulator in order to reset pageFaultCount and the pagetable for the next process 
-      PageReplacementSimulator pageSimulator;
-      PageTable pageTable(pageInt);
-      pid = to_string(processes[i].pid);   
-      pageSimulator.simulation(processes[i].addresses, pid, pageTable, frameInt, pageInt, frameSizeInt, flags[VERBOSE_FLAG], pagerType);
-    }
-    cout << "\n\tPlease note that processes are paged in the order in which they appear in \"" << fileName << "\"\n";
-    cout << "Paging successful!\n\n";
+  if(strcmp(schedulerType.c_str(),FIRST_COME_FIRST_SERVE) && atoi(threads.c_str()) > 1){
+    cout << "\tERROR: " << THREADS << " can only be used with FCFS, other schedulers page their processes interleaved in one timeline\n";
+    error = true;
   }
-  return 0;
-}
-
-bool addressErrorCheck(int pid,int pageSize, int pages, string address){
-  if(!integerCheck(address)){
-    cout << "\tERROR: Address " << address << " of " << PID_FORM << pid << " must be a non-negative integer\n";
-    return true;  
+  if(flags[SWEEP_FLAG] && (flags[VERBOSE_FLAG] || flags[LOG_LEVEL_FLAG] || atoi(threads.c_str()) > 1)){
+    cout << "\tERROR: " << SWEEP << " only reports page fault totals and cannot be combined with " << VERBOSE << ", " << LOG_LEVEL << ", or " << THREADS << "\n";
+    error = true;
   }
-  // check if a process's address is possible within given frames and size
-  else if((atoi(address.c_str())/pageSize) >= pages){
-    cout << "\tERROR: Address " << address << " of " << PID_FORM << pid << " cannot exist within " << pages << " " << pageSize << " byte pages\n";
-    return true;
+  if(flags[REPORT_FLAG] && reportFormat != JSON_REPORT && reportFormat != CSV_REPORT){
+    cout << "\tERROR: " << reportFormat << " is not a valid report format {" << JSON_REPORT << "|" << CSV_REPORT << "}\n";
+    error = true;
   }
-  return false;
-}
-
-bool loadErrorCheck(int pid, string arrival, string burst, string priority){
-  bool error = false;
-  if(!integerCheck(arrival) || atoi(arrival.c_str()) < 0){
-    cout << "\tERROR: Arrival time of " << PID_FORM << pid << " must be a non-negative integer\n";
+  if(flags[REPORT_FLAG] && (flags[SWEEP_FLAG] || flags[CONVERT_FLAG])){
+    cout << "\tERROR: " << REPORT << " reports on a paging and scheduling run and cannot be combined with " << SWEEP << " or " << CONVERT << "\n";
     error = true;
   }
-  if(!integerCheck(burst) || atoi(burst.c_str()) <= 0){
-    cout << "\tERROR: CPU burst of " << PID_FORM << pid << " must be a non-negative integer\n";
+  if(logLevel != SUMMARY_LEVEL && logLevel != PROCESS_LEVEL && logLevel != REFERENCE_LEVEL){
+    cout << "\tERROR: " << logLevel << " is not a valid log level {" << SUMMARY_LEVEL << "|" << PROCESS_LEVEL << "|" << REFERENCE_LEVEL << "}\n";
     error = true;
   }
-  if(!integerCheck(priority) || (atoi(priority.c_str()) > MAX_PRIORITY || atoi(priority.c_str()) < MIN_PRIORITY)){
-    cout << "\tERROR: Priority of " << PID_FORM << pid << " must be an integer from " << MIN_PRIORITY << " to " << MAX_PRIORITY << "\n";
+  if(flags[VERBOSE_FLAG] && flags[LOG_LEVEL_FLAG]){
+    cout << "\tERROR: " << VERBOSE << " is the same as " << LOG_LEVEL << " " << REFERENCE_LEVEL << ", only one of them can be entered\n";
     error = true;
   }
-  return error;
-}
-
-bool integerCheck(string integerString){
-  int integer = atoi(integerString.c_str());
-  string comparisonString, zeros = "";
-  
-  // makes a string of the prepended zeros and stops once a non-zero character is found
-  for(int i=0;i<integerString.length();i++){
-    if(integerString[i]=='0'){
-      zeros += integerString[i];
+  if(!integerCheck(logSample) || atoi(logSample.c_str()) <= 0){
+    cout << "\tERROR: Log sample must be a positive integer\n";
+    error = true;
+  }
+  int tlbEntryCount, tlbWayCount;
+  if(parseInteger(tlbEntries, tlbEntryCount) != PARSE_OK || tlbEntryCount < 0 || tlbEntryCount > MAX_TLB_ENTRIES){
+    cout << "\tERROR: TLB entries must be an integer between 0 and " << MAX_TLB_ENTRIES << "\n";
+    error = true;
+  }
+  else if(flags[TLB_WAYS_FLAG]){
+    if(!tlbEntryCount){
+      cout << "\tERROR: " << TLB_WAYS << " requires " << TLB_ENTRIES << "\n";
+      error = true;
     }
-    else{
-      i=integerString.length();
+    else if(parseInteger(tlbWays, tlbWayCount) != PARSE_OK || tlbWayCount <= 0 || tlbEntryCount % tlbWayCount){
+      cout << "\tERROR: TLB ways must be a positive integer that divides the number of TLB entries\n";
+      error = true;
     }
   }
-  // adds the zeros in front of the converted integer to account for any integers with prepended zeros
-  comparisonString = zeros + to_string(integer);
-  // if the integerString is a positive integer prepended with zero(s) or not, it will be accepted
-  // OR if the integerString is just a bunch of zeros then it will also be accepted
-  if(!strcmp(zeros.c_str(),integerString.c_str()) || !strcmp(comparisonString.c_str(),integerString.c_str())) return true;
-  return false;
-}
-
-bool inputErrorCheck(string pages, string frames, string frameSize, string schedulerType, string quanta, bool *flags){
-  bool error = false;
-  if(!strcmp(schedulerType.c_str(),FIRST_COME_FIRST_SERVE) && flags[PREEMPTIVE_FLAG]){
-    cout << "\tERROR: FCFS cannot be preemptive\n";
+  if(flags[GLOBAL_FLAG] && (flags[SWEEP_FLAG] || atoi(threads.c_str()) > 1 || atoi(tlbEntries.c_str()) > 0)){
+    cout << "\tERROR: " << GLOBAL_FRAMES << " pages every process through one shared pool and cannot be combined with " << SWEEP << ", " << THREADS << ", or " << TLB_ENTRIES << "\n";
     error = true;
   }
-  if(!strcmp(schedulerType.c_str(),ROUND_ROBIN) && !flags[PREEMPTIVE_FLAG]){
-    cout << "\tERROR: RR must be preemptive\n";
+  vector<string_view> pagerTypes = splitList(pagerType);
+  bool windowed = false;
+  for(size_t i=0;i<pagerTypes.size();i++){
+    if(pagerTypes[i] == WORKING_SET_CLOCK || pagerTypes[i] == PAGE_FAULT_FREQUENCY) windowed = true;
+  }
+  if(!windowed && flags[WINDOW_FLAG]){
+    cout << "\tERROR: Only WSClock and PFF should have a window specification\n";
     error = true;
   }
-  if(strcmp(schedulerType.c_str(),ROUND_ROBIN) && flags[QUANTA_FLAG]){
-    cout << "\tERROR: Only RR should have a quanta specification\n";
+  if(flags[WINDOW_FLAG] && (!integerCheck(window) || atoi(window.c_str()) <= 0)){
+    cout << "\tERROR: Window must be a positive integer\n";
     error = true;
   }
-  if(flags[QUANTA_FLAG] && (!integerCheck(quanta) || (atoi(quanta.c_str()) <= 0))){
-    cout << "\tERROR: Quanta must be a positive integer\n";
+  if(flags[GLOBAL_FLAG] && pagerType == PAGE_FAULT_FREQUENCY){
+    cout << "\tERROR: PFF sizes each process's own resident set and cannot be combined with " << GLOBAL_FRAMES << "\n";
     error = true;
   }
-  if(!integerCheck(pages) || atoi(pages.c_str()) <= 0){
-    cout << "\tERROR: Pages must be a positive integer\n";
+  long long checkpointReferences;
+  if(flags[CHECKPOINT_EVERY_FLAG] && !flags[CHECKPOINT_FLAG]){
+    cout << "\tERROR: " << CHECKPOINT_EVERY << " requires " << CHECKPOINT << "\n";
+    error = true;
+  }
+  if(parseInteger(checkpointEvery, checkpointReferences) != PARSE_OK || checkpointReferences <= 0){
+    cout << "\tERROR: Checkpoint interval must be a positive integer\n";
+    error = true;
+  }
+  if((flags[CHECKPOINT_FLAG] || flags[RESUME_FLAG]) && (flags[SWEEP_FLAG] || flags[CONVERT_FLAG] || atoi(threads.c_str()) > 1)){
+    cout << "\tERROR: " << CHECKPOINT << " and " << RESUME << " checkpoint a paging and scheduling run and cannot be combined with " << SWEEP << ", " << CONVERT << ", or " << THREADS << "\n";
+    error = true;
+  }
+  if(flags[PIPELINE_FLAG] && ((!flags[SWEEP_FLAG] && strcmp(schedulerType.c_str(),FIRST_COME_FIRST_SERVE)) || flags[GLOBAL_FLAG] || flags[CHECKPOINT_FLAG] || flags[RESUME_FLAG] || flags[CONVERT_FLAG])){
+    cout << "\tERROR: " << PIPELINE << " overlaps parsing with paging processes in file order, so it needs FCFS or " << SWEEP << " and cannot be combined with " << GLOBAL_FRAMES << ", " << CHECKPOINT << ", " << RESUME << ", or " << CONVERT << "\n";
+    error = true;
+  }
+  if(flags[PERF_EVENTS_FLAG] && !flags[PROFILE_FLAG]){
+    cout << "\tERROR: " << PERF_EVENTS << " requires " << PROFILE << "\n";
+    error = true;
+  }
+  if(flags[PROFILE_FLAG] && flags[REPORT_FLAG]){
+    cout << "\tERROR: " << PROFILE << " prints its breakdown after the run's output and cannot be combined with " << REPORT << "\n";
+    error = true;
+  }
+  if(flags[SWEEP_FLAG] && atoi(tlbEntries.c_str()) > 0){
+    cout << "\tERROR: " << SWEEP << " only reports page fault totals and cannot be combined with " << TLB_ENTRIES << "\n";
     error = true;
   }
-  if(!integerCheck(frames) || (atoi(frames.c_str()) <= 0 || atoi(frames.c_str()) > MAX_FRAMES)){
-    cout << "\tERROR: Frames must be a positive integer between 1 and " << MAX_FRAMES << "\n";
+  if(!integerCheck(threads) || atoi(threads.c_str()) <= 0){
+    cout << "\tERROR: Threads must be a positive integer\n";
     error = true;
   }
   if(!integerCheck(frameSize) || atoi(frameSize.c_str()) <= 0){
@@ -382,15 +692,15 @@ bool inputErrorCheck(string pages, string frames, string frameSize, string sched
 int commandErrorCheck(int argc, char** argv){
   bool error = false;
   int fileIndex = 0;
-  if(!strcmp(argv[argc-1],PAGER_TYPE) || !strcmp(argv[argc-1],SCHEDULER_TYPE) || !strcmp(argv[argc-1],PAGES) || !strcmp(argv[argc-1],FRAMES) || !strcmp(argv[argc-1],FRAME_SIZE) || !strcmp(argv[argc-1],QUANTA)){
+  if(!strcmp(argv[argc-1],PAGER_TYPE) || !strcmp(argv[argc-1],SCHEDULER_TYPE) || !strcmp(argv[argc-1],PAGES) || !strcmp(argv[argc-1],FRAMES) || !strcmp(argv[argc-1],FRAME_SIZE) || !strcmp(argv[argc-1],QUANTA) || !strcmp(argv[argc-1],CONVERT) || !strcmp(argv[argc-1],THREADS) || !strcmp(argv[argc-1],REPORT) || !strcmp(argv[argc-1],LOG_LEVEL) || !strcmp(argv[argc-1],LOG_SAMPLE) || !strcmp(argv[argc-1],TLB_ENTRIES) || !strcmp(argv[argc-1],TLB_WAYS) || !strcmp(argv[argc-1],WINDOW) || !strcmp(argv[argc-1],BATCH) || !strcmp(argv[argc-1],CHECKPOINT) || !strcmp(argv[argc-1],CHECKPOINT_EVERY) || !strcmp(argv[argc-1],RESUME)){
     cout << "\tERROR: " << argv[argc-1] << " requires an input\n";
     error = true;
   }
   else{
     for(int i=1;i<argc;i++){
       // if one of the inputs is not a valid option and does not come after an option that requires an input then there's an error
-      if(strcmp(argv[i],PAGER_TYPE) && strcmp(argv[i],SCHEDULER_TYPE) && strcmp(argv[i],PAGES) && strcmp(argv[i],FRAMES) && strcmp(argv[i],FRAME_SIZE) && strcmp(argv[i],QUANTA) && strcmp(argv[i],PREEMPTIVE) && strcmp(argv[i],VERBOSE)){
-        if(strcmp(argv[i-1],PAGER_TYPE) && strcmp(argv[i-1],SCHEDULER_TYPE) && strcmp(argv[i-1],PAGES) && strcmp(argv[i-1],FRAMES) && strcmp(argv[i-1],FRAME_SIZE) && strcmp(argv[i-1],QUANTA)){
+      if(strcmp(argv[i],PAGER_TYPE) && strcmp(argv[i],SCHEDULER_TYPE) && strcmp(argv[i],PAGES) && strcmp(argv[i],FRAMES) && strcmp(argv[i],FRAME_SIZE) && strcmp(argv[i],QUANTA) && strcmp(argv[i],PREEMPTIVE) && strcmp(argv[i],VERBOSE) && strcmp(argv[i],CONVERT) && strcmp(argv[i],THREADS) && strcmp(argv[i],SWEEP) && strcmp(argv[i],REPORT) && strcmp(argv[i],LOG_LEVEL) && strcmp(argv[i],LOG_SAMPLE) && strcmp(argv[i],TLB_ENTRIES) && strcmp(argv[i],TLB_WAYS) && strcmp(argv[i],GLOBAL_FRAMES) && strcmp(argv[i],WINDOW) && strcmp(argv[i],BATCH) && strcmp(argv[i],CHECKPOINT) && strcmp(argv[i],CHECKPOINT_EVERY) && strcmp(argv[i],RESUME) && strcmp(argv[i],PIPELINE) && strcmp(argv[i],PROFILE) && strcmp(argv[i],PERF_EVENTS)){
+        if(strcmp(argv[i-1],PAGER_TYPE) && strcmp(argv[i-1],SCHEDULER_TYPE) && strcmp(argv[i-1],PAGES) && strcmp(argv[i-1],FRAMES) && strcmp(argv[i-1],FRAME_SIZE) && strcmp(argv[i-1],QUANTA) && strcmp(argv[i-1],CONVERT) && strcmp(argv[i-1],THREADS) && strcmp(argv[i-1],REPORT) && strcmp(argv[i-1],LOG_LEVEL) && strcmp(argv[i-1],LOG_SAMPLE) && strcmp(argv[i-1],TLB_ENTRIES) && strcmp(argv[i-1],TLB_WAYS) && strcmp(argv[i-1],WINDOW) && strcmp(argv[i-1],BATCH) && strcmp(argv[i-1],CHECKPOINT) && strcmp(argv[i-1],CHECKPOINT_EVERY) && strcmp(argv[i-1],RESUME)){
           if(i!=argc-1){
             cout << "\tERROR: " << argv[i] << " is not a valid option\n";
             error = true;
@@ -401,9 +711,12 @@ int commandErrorCheck(int argc, char** argv){
         }
       }
       else if(!strcmp(argv[i],PAGER_TYPE)){
-        if(strcmp(argv[i+1],FIRST_IN_FIRST_OUT) && strcmp(argv[i+1],LEAST_RECENT_USED) && strcmp(argv[i+1],MOST_FREQUENT_USED) && strcmp(argv[i+1],RANDOM)){
-          cout << "\tERROR: " << argv[i+1] << " is not a valid pager type {FIFO|LRU|MFU|Random}\n";
-          error = true;
+        vector<string_view> types = splitList(argv[i+1]);
+        for(size_t j=0;j<types.size();j++){
+          if(types[j]!=FIRST_IN_FIRST_OUT && types[j]!=LEAST_RECENT_USED && types[j]!=MOST_FREQUENT_USED && types[j]!=RANDOM && types[j]!=OPTIMAL && types[j]!=WORKING_SET_CLOCK && types[j]!=PAGE_FAULT_FREQUENCY){
+            cout << "\tERROR: " << types[j] << " is not a valid pager type {FIFO|LRU|MFU|Random|OPT|WSClock|PFF}\n";
+            error = true;
+          }
         }
       }
       else if(!strcmp(argv[i],SCHEDULER_TYPE)){
@@ -419,16 +732,3 @@ int commandErrorCheck(int argc, char** argv){
   }
   return fileIndex;
 }
-
-bool idErrorCheck(string fileInput){
-  bool error = false;
-  if(fileInput.find(PID_FORM) != 0 || fileInput.length() < 3){
-    cout << "\tERROR: Process id " << fileInput << " is not of form " << PID_FORM << "#\n";
-    error = true;
-  }
-  else if(!integerCheck(fileInput.substr(2,fileInput.length()).c_str()) || atoi(fileInput.substr(2,fileInput.length()).c_str()) < 0){
-    cout << "\tERROR: Process id " << fileInput << " must be a non-negative integer\n";
-    error = true;
-  }
-  return error;
-}
@@ -1,95 +1,179 @@
-// FILE: babyOS.h
-// A Bautista, B Franco, E Mora
-// OS, Fall 2023, Transy U
-//
-//	interface for babyOs that holds the definitions, structures, and function prototypes to error check
-//	for valid command line inputs, set up, and option combinations. Also contains the error checking 
-//	function prototypes needed to ensure proper input file set up and values
-// 
-
-#ifndef BABY_H
-#define BABY_H
-
-#include <string>
-#include <limits.h>
-#include <queue>
-
-using namespace std;
-
-#define INPUT_MAX CHAR_MAX
-#define MAX_FRAMES 65536
-#define PID_FORM "P_"
-#define MIN_PRIORITY 0
-#define MAX_PRIORITY 100
-
-#define PAGER_TYPE "--pagerType"
-#define FRAMES "--frames"
-#define FRAME_SIZE "--framesize"
-#define PAGES "--pages"
-#define FIRST_IN_FIRST_OUT "FIFO"
-#define LEAST_RECENT_USED "LRU"
-#define MOST_FREQUENT_USED "MFU"
-
-#define SCHEDULER_TYPE "--schedulerType"
-#define PREEMPTIVE "--preemptive"
-#define QUANTA "--quanta"
-#define VERBOSE "--verbose"
-#define FIRST_COME_FIRST_SERVE "FCFS"
-#define SHORTEST_JOB_FIRST "SJF"
-#define PRIORITY "Priority"
-#define ROUND_ROBIN "RR"
-#define RANDOM "Random"
-
-#define DEFAULT_SCHEDULER_TYPE FIRST_COME_FIRST_SERVE
-#define DEFAULT_PAGER_TYPE FIRST_IN_FIRST_OUT
-#define DEFAULT_FRAMES "3"
-#define DEFAULT_PAGES "8"
-#define DEFAULT_SIZE "512"
-#define DEFAULT_QUANTA "10"
-#define DEFAULT_FILE "final.in"
-
-#define CPU_FILE "FCFS_CPU_FILE"
-
-enum{
-  PREEMPTIVE_FLAG,
-  QUANTA_FLAG,
-  VERBOSE_FLAG,
-  MAX_FLAGS
-};
-
-struct PCB{
-  int pid, arrival, burst, priority;
-  queue<int> addresses;
-};
-
-// checks if an address is an integer and if it can exist in the number of pages of size pageSize
-// the pid is taken in to print the pid where the error was found
-// returns false if no error were found
-bool addressErrorCheck(int pid,int pageSize, int pages, string address);
-
-// checks if arrival, burst, and priority are non-negative integers and if priority is between MIN_PRIORITY and MAX_PRIORITY inclusive
-// the pid is taken in to print the pid where the error was found
-// returns false if no error were found
-bool loadErrorCheck(int pid, string arrival, string burst, string priority);
-
-// checks if the given integerString is indeed an integer, returns true if it is an integer
-// integerCheck allows for prepended zeros
-bool integerCheck(string integerString);
-
-// ensures that entered input options don't conflict
-// checks if pages, frames, frameSize, and quanta are positive integers
-// frameSize at most can be MAX_FRAMES
-// returns false if no error were found
-bool inputErrorCheck(string pages, string frames, string frameSize, string schedulerType, string quanta, bool *flags);
-
-// checks if all options that require inputs have inputs, if there are any invalid options, and if entered types are valid
-// returns -1 if an error was found
-// returns 0 if no errors were found and no file name was specified
-// returns the index of the file name in argv if no errors were found and the file name was specified
-// file name can currently only be at the last index of argv
-int commandErrorCheck(int argc, char** argv);
-
-// checks if the process id is valid and in the proper format, returns false if no errors were found
-bool idErrorCheck(string fileInput);
-
-#endif // BABY_H
+// FILE: babyOS.h
+// A Bautista, B Franco, E Mora
+// OS, Fall 2023, Transy U
+//
+//	interface for babyOs that holds the definitions, structures, and function prototypes to error check
+//	for valid command line inputs, set up, and option combinations. Also contains the error checking 
+//	function prototypes needed to ensure proper input file set up and values
+// 
+
+#ifndef BABY_H
+#define BABY_H
+
+#include <string>
+#include <string_view>
+#include <limits.h>
+#include <stdint.h>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+#define INPUT_MAX CHAR_MAX
+// number of characters of an argument too long for INPUT_MAX that its error shows
+#define INPUT_ARGUMENT_SHOWN 32
+#define MAX_FRAMES 65536
+#define MAX_TLB_ENTRIES 65536
+// addresses may be up to this many bits wide, --pages * --framesize can be at most 2^MAX_ADDRESS_BITS
+#define MAX_ADDRESS_BITS 48
+#define PID_FORM "P_"
+#define MIN_PRIORITY 0
+#define MAX_PRIORITY 100
+
+#define PAGER_TYPE "--pagerType"
+#define FRAMES "--frames"
+#define FRAME_SIZE "--framesize"
+#define PAGES "--pages"
+#define FIRST_IN_FIRST_OUT "FIFO"
+#define LEAST_RECENT_USED "LRU"
+#define MOST_FREQUENT_USED "MFU"
+#define OPTIMAL "OPT"
+#define WORKING_SET_CLOCK "WSClock"
+#define PAGE_FAULT_FREQUENCY "PFF"
+
+#define SCHEDULER_TYPE "--schedulerType"
+#define PREEMPTIVE "--preemptive"
+#define QUANTA "--quanta"
+#define VERBOSE "--verbose"
+#define CONVERT "--convert"
+#define THREADS "--threads"
+#define SWEEP "--sweep"
+#define REPORT "--report"
+#define LOG_LEVEL "--logLevel"
+#define LOG_SAMPLE "--logSample"
+#define TLB_ENTRIES "--tlb-entries"
+#define TLB_WAYS "--tlb-ways"
+#define GLOBAL_FRAMES "--global-frames"
+#define WINDOW "--window"
+#define BATCH "--batch"
+#define CHECKPOINT "--checkpoint"
+#define CHECKPOINT_EVERY "--checkpointEvery"
+#define RESUME "--resume"
+#define PIPELINE "--pipeline"
+#define PROFILE "--profile"
+#define PERF_EVENTS "--perf-events"
+#define FIRST_COME_FIRST_SERVE "FCFS"
+#define SHORTEST_JOB_FIRST "SJF"
+#define PRIORITY "Priority"
+#define ROUND_ROBIN "RR"
+#define RANDOM "Random"
+#define SUMMARY_LEVEL "summary"
+#define PROCESS_LEVEL "process"
+#define REFERENCE_LEVEL "reference"
+
+#define DEFAULT_SCHEDULER_TYPE FIRST_COME_FIRST_SERVE
+#define DEFAULT_PAGER_TYPE FIRST_IN_FIRST_OUT
+#define DEFAULT_FRAMES "3"
+#define DEFAULT_PAGES "8"
+#define DEFAULT_SIZE "512"
+#define DEFAULT_QUANTA "10"
+#define DEFAULT_THREADS "1"
+#define DEFAULT_LOG_LEVEL SUMMARY_LEVEL
+#define DEFAULT_LOG_SAMPLE "1"
+#define DEFAULT_TLB_ENTRIES "0"
+#define DEFAULT_WINDOW "16"
+#define DEFAULT_CHECKPOINT_EVERY "1000000000"
+// a --batch job file of this name means standard input
+#define BATCH_STDIN "-"
+#define DEFAULT_FILE "final.in"
+
+enum{
+  PREEMPTIVE_FLAG,
+  QUANTA_FLAG,
+  VERBOSE_FLAG,
+  CONVERT_FLAG,
+  SWEEP_FLAG,
+  REPORT_FLAG,
+  LOG_LEVEL_FLAG,
+  TLB_WAYS_FLAG,
+  GLOBAL_FLAG,
+  WINDOW_FLAG,
+  BATCH_FLAG,
+  CHECKPOINT_FLAG,
+  CHECKPOINT_EVERY_FLAG,
+  RESUME_FLAG,
+  PIPELINE_FLAG,
+  PROFILE_FLAG,
+  PERF_EVENTS_FLAG,
+  MAX_FLAGS
+};
+
+// every option of one run as it was entered or its default, and which of the flags were entered
+// fileGiven is false if fileName is the default
+struct RunOptions{
+  char pagerType[INPUT_MAX], frames[INPUT_MAX], pages[INPUT_MAX], frameSize[INPUT_MAX];
+  char schedulerType[INPUT_MAX], quanta[INPUT_MAX], fileName[INPUT_MAX], convertFile[INPUT_MAX];
+  char threads[INPUT_MAX], reportFormat[INPUT_MAX], logLevel[INPUT_MAX], logSample[INPUT_MAX], tlbEntries[INPUT_MAX], tlbWays[INPUT_MAX];
+  char window[INPUT_MAX], batchFile[INPUT_MAX], checkpointFile[INPUT_MAX], checkpointEvery[INPUT_MAX], resumeFile[INPUT_MAX];
+  bool flags[MAX_FLAGS];
+  bool fileGiven;
+};
+
+// addresses is a span of burst addresses owned by whichever loader handed the process back, only valid until its next process
+struct PCB{
+  int pid, arrival, burst, priority;
+  const int64_t *addresses;
+};
+
+// checks if an address is a non-negative integer and if it can exist in the number of pages of size pageSize
+// the pid is taken in to print the pid where the error was found
+// the parsed address is stored in value
+// returns false if no error were found
+bool addressErrorCheck(int pid,int pageSize, long long pages, string_view address, long long &value);
+
+// checks if arrival, burst, and priority are non-negative integers and if priority is between MIN_PRIORITY and MAX_PRIORITY inclusive
+// the pid is taken in to print the pid where the error was found
+// the parsed values are stored in block
+// returns false if no error were found
+bool loadErrorCheck(int pid, string_view arrival, string_view burst, string_view priority, PCB &block);
+
+// checks if the given integerString is indeed an integer, returns true if it is an integer
+// integerCheck allows for prepended zeros
+bool integerCheck(string_view integerString);
+
+// ensures that entered input options don't conflict
+// checks if pages, frames, frameSize, quanta, and threads are positive integers
+// frames at most can be MAX_FRAMES and pages of frameSize bytes can cover at most MAX_ADDRESS_BITS bits of address
+// tlbEntries must be from 0 to MAX_TLB_ENTRIES and a multiple of tlbWays, which is only checked if --tlb-ways was entered
+// --global-frames cannot be combined with --sweep, --threads, a TLB, or PFF
+// window must be a positive integer and is only checked if --window was entered, which needs WSClock or PFF among the pager types
+// pagerType and frames may only be comma separated lists if --sweep was entered, in which case each frame count is checked
+// checkpointEvery must be a positive integer and is only checked if --checkpointEvery was entered, which needs --checkpoint
+// --checkpoint and --resume cannot be combined with --sweep, --convert, or --threads
+// --pipeline needs FCFS or --sweep and cannot be combined with --global-frames, --checkpoint, --resume, or --convert
+// reportFormat is only checked if --report was entered and must be json or csv
+// logLevel must be summary, process, or reference and logSample a positive integer, --verbose is the same as --logLevel reference
+// returns false if no error were found
+bool inputErrorCheck(string pagerType, string pages, string frames, string frameSize, string schedulerType, string quanta, string threads, string reportFormat, string logLevel, string logSample, string tlbEntries, string tlbWays, string window, string checkpointEvery, bool *flags);
+
+// checks if all options that require inputs have inputs, if there are any invalid options, and if entered types are valid
+// a pager type may be a comma separated list, each one of which has to be valid
+// returns -1 if an error was found
+// returns 0 if no errors were found and no file name was specified
+// returns the index of the file name in argv if no errors were found and the file name was specified
+// file name can currently only be at the last index of argv
+int commandErrorCheck(int argc, char** argv);
+
+// parses argv as babyOS's command line into options, filling in the defaults, and error checks it with commandErrorCheck and inputErrorCheck
+// --batch may only be combined with --threads, and every argument has to be shorter than INPUT_MAX
+// returns false if an error was found, the errors have already been printed
+bool parseOptions(int argc, char **argv, RunOptions &options);
+
+// lists the options a run was made with as name, value pairs for a RunReport
+vector<pair<string, string>> runConfiguration(const RunOptions &options);
+
+// checks if the process id is valid and in the proper format, returns false if no errors were found
+// the parsed id is stored in pid
+bool idErrorCheck(string_view fileInput, int &pid);
+
+#endif // BABY_H
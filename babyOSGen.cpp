@@ -0,0 +1,265 @@
+// FILE: babyOSGen.cpp
+// A Bautista, B Franco, E Mora
+// OS, Fall 2023, Transy U
+//
+//	babyOS-gen writes large synthetic input files for babyOS in the same P_# arrival burst priority + addresses format
+//	as final.in, so the hot paths can be measured on more than a handful of processes
+//
+//	To use babyOS-gen	enter at the command line --processes #, --burst #, --arrivalGap #, --pages #, --framesize #, --seed #,
+//		--locality {locality}, --skew #, --workingSet #, and --phaseLength # to specify options, otherwise the defaults will be used
+//		to specify an output file, type the file name as the last argument, otherwise GEN_DEFAULT_FILE will be used
+//		--framesize has to be a power of two, as it does for babyOS, and the file name cannot start with "--"
+//	ex. ./babyOS-gen --processes 10000 --burst 1000 --pages 256 --locality zipf big.in
+//		./babyOS --pages 256 --frames 16 big.in
+//	Defaults: processes - 100, burst - 100, arrivalGap - 10, pages - 8, framesize - 512, seed - 2023, locality - uniform,
+//		skew - 1, workingSet - 4, phaseLength - 1000, file - gen.in
+//
+//	Each process's burst is drawn from 1 to 2 * --burst - 1, the gap to the next arrival from 0 to 2 * --arrivalGap,
+//	and its priority from MIN_PRIORITY to MAX_PRIORITY. Its addresses fall in a page picked by the locality model and anywhere within it
+//		uniform		every page is as likely as any other
+//		zipf		a page's chance falls off as 1 / rank^skew, which pages are hot is shuffled by the seed
+//		loop		each process loops over --workingSet consecutive pages starting from a random one
+//		phase		each process references --workingSet random pages uniformly and picks a new set every --phaseLength references
+//	Every value comes from one mt19937_64 seeded with --seed and is reduced with plain arithmetic rather than the
+//	standard distributions, whose output differs between standard libraries, so the same options always write the same file
+//
+
+#include "babyOS.h"
+#include "inputParse.h"
+#include <iostream>
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <stdio.h>
+#include <stdlib.h>
+#include <random>
+#include <vector>
+
+using namespace std;
+
+#define PROCESSES "--processes"
+#define BURST "--burst"
+#define ARRIVAL_GAP "--arrivalGap"
+#define SEED "--seed"
+#define LOCALITY "--locality"
+#define SKEW "--skew"
+#define WORKING_SET "--workingSet"
+#define PHASE_LENGTH "--phaseLength"
+#define UNIFORM_LOCALITY "uniform"
+#define ZIPF_LOCALITY "zipf"
+#define LOOP_LOCALITY "loop"
+#define PHASE_LOCALITY "phase"
+
+#define GEN_DEFAULT_PROCESSES "100"
+#define GEN_DEFAULT_BURST "100"
+#define GEN_DEFAULT_ARRIVAL_GAP "10"
+#define GEN_DEFAULT_SEED "2023"
+#define GEN_DEFAULT_SKEW "1"
+#define GEN_DEFAULT_WORKING_SET "4"
+#define GEN_DEFAULT_PHASE_LENGTH "1000"
+#define GEN_DEFAULT_FILE "gen.in"
+#define GEN_USAGE "usage: ./babyOS-gen [--processes #] [--burst #] [--arrivalGap #] [--pages #] [--framesize #] [--seed #]\n" \
+  "\t\t[--locality {uniform|zipf|loop|phase}] [--skew #] [--workingSet #] [--phaseLength #] [file]\n"
+// zipf keeps a table of every page's chance, so its address space is limited to this many pages
+#define GEN_MAX_ZIPF_PAGES (1 << 24)
+// addresses are written to a buffer of this size before each fwrite
+#define GEN_BUFFER_SIZE (1 << 20)
+
+enum Locality{
+  UNIFORM,
+  ZIPF,
+  LOOP,
+  PHASE
+};
+
+// returns a value from 0 to bound - 1, bound being far below 2^64 the modulo bias is negligible
+static long long draw(mt19937_64 &generator, long long bound){
+  return generator() % (unsigned long long)bound;
+}
+
+// returns a value in [0, 1)
+static double drawFraction(mt19937_64 &generator){
+  return (generator() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+// checks that value is an integer from minimum to maximum, printing an error naming option if it isn't
+template<class Integer>
+static bool genIntegerCheck(const char *option, const char *value, long long minimum, long long maximum, Integer &result){
+  if(parseInteger(value, result) != PARSE_OK || result < minimum || result > maximum){
+    cout << "\tERROR: " << option << " must be an integer from " << minimum << " to " << maximum << "\n";
+    return true;
+  }
+  return false;
+}
+
+int main(int argc, char **argv){
+  const char *options[] = {PROCESSES, BURST, ARRIVAL_GAP, PAGES, FRAME_SIZE, SEED, LOCALITY, SKEW, WORKING_SET, PHASE_LENGTH};
+  const char *values[] = {GEN_DEFAULT_PROCESSES, GEN_DEFAULT_BURST, GEN_DEFAULT_ARRIVAL_GAP, DEFAULT_PAGES, DEFAULT_SIZE,
+                          GEN_DEFAULT_SEED, UNIFORM_LOCALITY, GEN_DEFAULT_SKEW, GEN_DEFAULT_WORKING_SET, GEN_DEFAULT_PHASE_LENGTH};
+  const int optionCount = sizeof(options) / sizeof(options[0]);
+  bool entered[optionCount] = {false};
+  const char *fileName = GEN_DEFAULT_FILE;
+  bool error = false;
+
+  // every option takes a value, anything else may only be the output file name as the last argument
+  // and an output file name may not start with "--", so a mistyped option is never taken for one
+  for(int i=1;i<argc;i++){
+    int option = 0;
+    while(option < optionCount && strcmp(argv[i],options[option])) option++;
+    if(option == optionCount){
+      if(i != argc-1 || !strncmp(argv[i], "--", 2)){
+        cout << "\tERROR: " << argv[i] << " is not a valid option\n" << GEN_USAGE;
+        exit(1);
+      }
+      fileName = argv[i];
+    }
+    else if(i == argc-1){
+      cout << "\tERROR: " << argv[i] << " requires an input\n";
+      exit(1);
+    }
+    else if(entered[option]){
+      cout << "\tERROR: " << argv[i] << " has been entered multiple times\n";
+      exit(1);
+    }
+    else{
+      entered[option] = true;
+      values[option] = argv[++i];
+    }
+  }
+
+  int processes = 0, burst = 0, arrivalGap = 0, frameSize = 0, seed = 0, workingSet = 0, phaseLength = 0;
+  long long pages = 0;
+  error |= genIntegerCheck(PROCESSES, values[0], 1, INT_MAX, processes);
+  error |= genIntegerCheck(BURST, values[1], 1, INT_MAX / 2, burst);
+  error |= genIntegerCheck(ARRIVAL_GAP, values[2], 0, INT_MAX / 2, arrivalGap);
+  error |= genIntegerCheck(PAGES, values[3], 1, 1LL << MAX_ADDRESS_BITS, pages);
+  // babyOS only takes a frame size that is a power of two, a trace written for any other size couldn't be run
+  if(genIntegerCheck(FRAME_SIZE, values[4], 1, INT_MAX, frameSize)) error = true;
+  else if(frameSize & (frameSize - 1)){
+    cout << "\tERROR: " << FRAME_SIZE << " must be a power of two\n";
+    error = true;
+  }
+  error |= genIntegerCheck(SEED, values[5], 0, INT_MAX, seed);
+  error |= genIntegerCheck(WORKING_SET, values[8], 1, INT_MAX, workingSet);
+  error |= genIntegerCheck(PHASE_LENGTH, values[9], 1, INT_MAX, phaseLength);
+  if(!error && pages > (1LL << MAX_ADDRESS_BITS) / frameSize){
+    cout << "\tERROR: " << pages << " pages of " << frameSize << " bytes cover more than a " << MAX_ADDRESS_BITS << "-bit address space\n";
+    error = true;
+  }
+  if(!error && workingSet > pages){
+    cout << "\tERROR: " << WORKING_SET << " cannot be larger than " << PAGES << "\n";
+    error = true;
+  }
+
+  Locality locality = UNIFORM;
+  if(!strcmp(values[6], ZIPF_LOCALITY)){
+    locality = ZIPF;
+    if(!error && pages > GEN_MAX_ZIPF_PAGES){
+      cout << "\tERROR: " << ZIPF_LOCALITY << " locality can only cover up to " << GEN_MAX_ZIPF_PAGES << " pages\n";
+      error = true;
+    }
+  }
+  else if(!strcmp(values[6], LOOP_LOCALITY)) locality = LOOP;
+  else if(!strcmp(values[6], PHASE_LOCALITY)) locality = PHASE;
+  else if(strcmp(values[6], UNIFORM_LOCALITY)){
+    cout << "\tERROR: " << values[6] << " is not a valid locality {uniform|zipf|loop|phase}\n";
+    error = true;
+  }
+
+  char *skewEnd;
+  double skew = strtod(values[7], &skewEnd);
+  if(*skewEnd || skewEnd == values[7] || !(skew >= 0)){
+    cout << "\tERROR: " << SKEW << " must be a non-negative number\n";
+    error = true;
+  }
+  if(error) exit(1);
+
+  FILE *file = fopen(fileName, "w");
+  if(!file){
+    cout << "\tERROR: File not opened\n";
+    exit(1);
+  }
+
+  mt19937_64 generator(seed);
+  // for zipf, cumulative chance of each rank and the page each rank stands for
+  vector<double> cumulative;
+  vector<int> pageOfRank;
+  vector<long long> workingPages(workingSet);
+  if(locality == ZIPF){
+    double total = 0;
+    cumulative.resize(pages);
+    pageOfRank.resize(pages);
+    for(int rank=0;rank<pages;rank++){
+      total += 1.0 / pow(rank + 1, skew);
+      cumulative[rank] = total;
+      pageOfRank[rank] = rank;
+    }
+    for(int rank=0;rank<pages;rank++) cumulative[rank] /= total;
+    for(int rank=pages-1;rank>0;rank--) swap(pageOfRank[rank], pageOfRank[draw(generator, rank + 1)]);
+  }
+
+  vector<char> buffer(GEN_BUFFER_SIZE);
+  size_t used = 0;
+  long long arrival = 0;
+  // room for a line of the process header or one address
+  const size_t lineMax = 64;
+  auto writeNumber = [&](long long number, char after){
+    used = to_chars(buffer.data() + used, buffer.data() + buffer.size(), number).ptr - buffer.data();
+    buffer[used++] = after;
+  };
+
+  for(int pid=0;pid<processes;pid++){
+    int processBurst = 1 + draw(generator, 2LL * burst - 1);
+    int priority = MIN_PRIORITY + draw(generator, MAX_PRIORITY - MIN_PRIORITY + 1);
+    long long loopStart = draw(generator, pages);
+    if(arrival > INT_MAX){
+      cout << "\tERROR: Arrival times have grown too large for babyOS, use a smaller " << ARRIVAL_GAP << " or fewer " << PROCESSES << "\n";
+      fclose(file);
+      exit(1);
+    }
+
+    if(used + lineMax > buffer.size()){
+      fwrite(buffer.data(), 1, used, file);
+      used = 0;
+    }
+    memcpy(buffer.data() + used, PID_FORM, strlen(PID_FORM));
+    used += strlen(PID_FORM);
+    writeNumber(pid, ' ');
+    writeNumber(arrival, ' ');
+    writeNumber(processBurst, ' ');
+    writeNumber(priority, '\n');
+
+    for(int reference=0;reference<processBurst;reference++){
+      long long page;
+      if(locality == ZIPF){
+        page = pageOfRank[lower_bound(cumulative.begin(), cumulative.end(), drawFraction(generator)) - cumulative.begin()];
+      }
+      else if(locality == LOOP){
+        page = (loopStart + reference % workingSet) % pages;
+      }
+      else if(locality == PHASE){
+        if(reference % phaseLength == 0){
+          for(int i=0;i<workingSet;i++) workingPages[i] = draw(generator, pages);
+        }
+        page = workingPages[draw(generator, workingSet)];
+      }
+      else{
+        page = draw(generator, pages);
+      }
+
+      if(used + lineMax > buffer.size()){
+        fwrite(buffer.data(), 1, used, file);
+        used = 0;
+      }
+      writeNumber(page * frameSize + draw(generator, frameSize), reference == processBurst - 1 ? '\n' : ' ');
+    }
+    arrival += draw(generator, 2LL * arrivalGap + 1);
+  }
+  fwrite(buffer.data(), 1, used, file);
+  if(fclose(file)){
+    cout << "\tERROR: " << fileName << " could not be written\n";
+    exit(1);
+  }
+  return 0;
+}
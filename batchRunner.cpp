@@ -0,0 +1,216 @@
+// FILE: batchRunner.cpp
+// A Bautista, B Franco, E Mora
+// OS, Fall 2023, Transy U
+//
+//	implementation of --batch
+//
+//	Only the reading thread parses jobs and loads traces, so the trace cache needs no lock and parseOptions and the loaders
+//	can keep printing their errors to cout, which is swapped for a string's buffer around them and turned into the job's error line
+//	Workers only read the cached traces, each job gets its own Scheduler, pager, and RunReport, and a finished line is
+//	printed whole under outputMutex so that lines from different workers never interleave
+//	No more than BATCH_WINDOW jobs per worker wait at once, past that the job file isn't read until a worker takes one
+//
+
+#include "batchRunner.h"
+#include "eventLog.h"
+#include "report.h"
+#include "scheduler.h"
+#include "traceLoader.h"
+#include <iostream>
+#include <sstream>
+#include <stdlib.h>
+
+using namespace std;
+
+BatchRunner::BatchRunner(int threads, streambuf *output) : output(output){
+  this->threads = threads;
+  stopping = false;
+}
+
+bool BatchRunner::run(istream &jobs){
+  vector<thread> workers;
+  string text;
+  long long line = 0;
+  bool succeeded = true;
+  for(int i=0;i<threads;i++) workers.emplace_back(&BatchRunner::work, this);
+
+  while(getline(jobs, text)){
+    line++;
+    size_t first = text.find_first_not_of(" \t\r");
+    if(first == string::npos || text[first] == BATCH_COMMENT) continue;
+
+    BatchJob *job = new BatchJob;
+    string error;
+    if(!prepare(line, text, *job, error)){
+      ostringstream record;
+      record << "{\"job\": " << line << ", \"error\": ";
+      writeJsonString(record, error);
+      record << "}\n";
+      print(record.str());
+      delete job;
+      succeeded = false;
+      continue;
+    }
+
+    unique_lock<mutex> lock(batchMutex);
+    jobTaken.wait(lock, [&]{ return pending.size() < (size_t)threads * BATCH_WINDOW; });
+    pending.push(job);
+    jobReady.notify_one();
+  }
+
+  {
+    lock_guard<mutex> lock(batchMutex);
+    stopping = true;
+  }
+  jobReady.notify_all();
+  for(size_t i=0;i<workers.size();i++) workers[i].join();
+  return succeeded;
+}
+
+bool BatchRunner::prepare(long long line, const string &text, BatchJob &job, string &error){
+  // the job is split into arguments the way a shell without quoting would, after a stand in for the program name
+  istringstream words(text);
+  vector<string> arguments(1, "babyOS");
+  string word;
+  while(words >> word) arguments.push_back(word);
+  vector<char *> argv;
+  for(size_t i=0;i<arguments.size();i++) argv.push_back(&arguments[i][0]);
+  argv.push_back(NULL);
+
+  ostringstream errors;
+  streambuf *original = cout.rdbuf(errors.rdbuf());
+  RunOptions &options = job.options;
+  bool valid = parseOptions(argv.size() - 1, argv.data(), options);
+  if(valid && (options.flags[BATCH_FLAG] || options.flags[CONVERT_FLAG] || options.flags[SWEEP_FLAG] || options.flags[REPORT_FLAG]
+               || options.flags[VERBOSE_FLAG] || options.flags[LOG_LEVEL_FLAG]
+               || options.flags[CHECKPOINT_FLAG] || options.flags[RESUME_FLAG] || options.flags[PIPELINE_FLAG] || options.flags[PROFILE_FLAG] || atoi(options.threads) > 1)){
+    cout << "\tERROR: " << BATCH << ", " << CONVERT << ", " << SWEEP << ", " << REPORT << ", " << VERBOSE << ", " << LOG_LEVEL << ", "
+         << CHECKPOINT << ", " << RESUME << ", " << PIPELINE << ", " << PROFILE << ", and " << THREADS << " cannot be used in a batch job\n";
+    valid = false;
+  }
+  if(valid){
+    job.trace = load(options);
+    valid = job.trace != NULL;
+  }
+  if(valid){
+    // the trace was read against the widest address space, so only its largest address has to fit this job's
+    int pageSize = atoi(options.frameSize);
+    long long pages = atoll(options.pages);
+    const CachedTrace &trace = *job.trace;
+    if(trace.table.size() && trace.maxAddress / pageSize >= pages){
+      cout << "\tERROR: Address " << trace.maxAddress << " of ";
+      if(trace.binary) cout << options.fileName;
+      else cout << PID_FORM << trace.maxPid;
+      cout << " cannot exist within " << pages << " " << pageSize << " byte pages\n";
+      valid = false;
+    }
+  }
+  cout.rdbuf(original);
+  job.line = line;
+
+  // the error lines are joined into one message without their tabs
+  istringstream lines(errors.str());
+  string message;
+  while(getline(lines, word)){
+    size_t first = word.find_first_not_of('\t');
+    if(first == string::npos) continue;
+    if(!message.empty()) message += " ";
+    message += word.substr(first);
+  }
+  if(!valid) error = message.empty() ? "Job could not be run" : message;
+  return valid;
+}
+
+const CachedTrace *BatchRunner::load(const RunOptions &options){
+  auto found = traces.find(options.fileName);
+  if(found != traces.end()) return found->second.get();
+
+  unique_ptr<CachedTrace> trace(new CachedTrace);
+  long long widest = 1LL << MAX_ADDRESS_BITS;
+  trace->binary = isTraceFile(options.fileName);
+  trace->maxAddress = 0;
+  trace->maxPid = 0;
+  if(trace->binary){
+    if(!trace->mapped.open(options.fileName, 1, widest)) return NULL;
+    trace->mapped.fillTable(trace->table);
+    trace->maxAddress = trace->mapped.maxAddress();
+  }
+  else{
+    TraceLoader loader;
+    if(!loader.open(options.fileName)){
+      cout << "\tERROR: File not opened\n";
+      return NULL;
+    }
+    if(!readTrace(loader, 1, widest, trace->table)) return NULL;
+    const ProcessTable &table = trace->table;
+    for(size_t i=0;i<table.size();i++){
+      const int64_t *addresses = table.processAddresses(i);
+      for(long long j=0;j<table.burst[i];j++){
+        if(addresses[j] > trace->maxAddress){
+          trace->maxAddress = addresses[j];
+          trace->maxPid = table.pid[i];
+        }
+      }
+    }
+  }
+  const CachedTrace *loaded = trace.get();
+  traces[options.fileName] = move(trace);
+  return loaded;
+}
+
+void BatchRunner::work(){
+  string line;
+  while(true){
+    BatchJob *job;
+    {
+      unique_lock<mutex> lock(batchMutex);
+      jobReady.wait(lock, [&]{ return stopping || !pending.empty(); });
+      if(pending.empty()) return;
+      job = pending.front();
+      pending.pop();
+    }
+    jobTaken.notify_one();
+    runJob(*job, line);
+    print(line);
+    delete job;
+  }
+}
+
+void BatchRunner::runJob(const BatchJob &job, string &line){
+  const RunOptions &options = job.options;
+  const CachedTrace &trace = *job.trace;
+  int frameSize = atoi(options.frameSize);
+  int pageShift = 0;
+  while((1 << pageShift) < frameSize) pageShift++;
+  int tlbEntries = atoi(options.tlbEntries);
+  int tlbWays = options.flags[TLB_WAYS_FLAG] ? atoi(options.tlbWays) : tlbEntries;
+  long long pages = atoll(options.pages);
+  PagerPolicy policy = policyFromName(options.pagerType);
+
+  // a job only reports its totals, so it logs nothing but what the summary level always keeps count of
+  ostream noOutput(NULL);
+  EventLog log(SUMMARY_LOG, 1, noOutput);
+  RunReport report;
+  vector<PagerStats> stats;
+  vector<ScheduleSlice> timeline;
+  Scheduler scheduler(schedulerFromName(options.schedulerType), options.flags[PREEMPTIVE_FLAG], atoi(options.quanta));
+
+  report.begin(SCHEDULE_PHASE);
+  scheduler.schedule(trace.table, timeline);
+  report.end(SCHEDULE_PHASE);
+  report.begin(PAGE_PHASE);
+  if(options.flags[GLOBAL_FLAG]) pageScheduleGlobal(timeline, trace.table, policy, atoi(options.frames), pages, atoi(options.window), pageShift, log, stats);
+  else pageSchedule(timeline, trace.table, policy, atoi(options.frames), pages, atoi(options.window), tlbEntries, tlbWays, pageShift, log, stats);
+  report.end(PAGE_PHASE);
+
+  report.collect(trace.table, stats, scheduler.wait, scheduler.turnaround);
+  ostringstream record;
+  report.writeLine(record, job.line, runConfiguration(options));
+  line = record.str();
+}
+
+void BatchRunner::print(const string &line){
+  lock_guard<mutex> lock(outputMutex);
+  output << line;
+  output.flush();
+}
@@ -0,0 +1,83 @@
+// FILE: batchRunner.h
+// A Bautista, B Franco, E Mora
+// OS, Fall 2023, Transy U
+//
+//	interface for --batch, which runs many configurations of babyOS in one invocation
+//	Each line of the job file is the options and input file of one run as they would be typed after ./babyOS, blank lines and
+//	lines starting with BATCH_COMMENT are skipped. A job is parsed and error checked by the same parseOptions as the command line,
+//	then scheduled and paged on a worker from the whole trace in memory, the way SJF, Priority, and RR are, and written out as
+//	one line of JSON (RunReport::writeLine) as soon as it finishes, so the lines come out in the order the jobs finished and
+//	each one carries its line number in the job file. A job that can't run is written as {"job": line, "error": "..."} instead
+//	Traces are cached by file name for the rest of the batch, a text trace is parsed once against the widest address space and
+//	only its largest address is checked against each job's --pages and --framesize, as a binary trace's already is
+//
+
+#ifndef BATCH_RUNNER_H
+#define BATCH_RUNNER_H
+
+#include "babyOS.h"
+#include "traceFile.h"
+#include <condition_variable>
+#include <istream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <queue>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+#define BATCH_COMMENT '#'
+// number of jobs that may wait for a worker per worker before the job file stops being read
+#define BATCH_WINDOW 4
+
+// one trace as every job that names it sees it
+struct CachedTrace{
+  MappedTrace mapped;
+  ProcessTable table;
+  // the largest address in the trace and, for a text trace, the process it belongs to
+  long long maxAddress;
+  int maxPid;
+  bool binary;
+};
+
+struct BatchJob{
+  long long line;
+  RunOptions options;
+  const CachedTrace *trace;
+};
+
+class BatchRunner{
+ public:
+  // runs jobs on threads workers, writing each job's line to output
+  BatchRunner(int threads, streambuf *output);
+
+  // runs every job in jobs, returns false if any of them couldn't be run
+  bool run(istream &jobs);
+
+ private:
+  // parses the job on line text into job, loading its trace if it isn't cached yet
+  // returns false and sets error to what went wrong if the job can't be run
+  bool prepare(long long line, const string &text, BatchJob &job, string &error);
+  // returns the cached trace for options' file, reading it in first if needed, NULL if it couldn't be read
+  const CachedTrace *load(const RunOptions &options);
+  void work();
+  // schedules and pages job and writes its results to line
+  void runJob(const BatchJob &job, string &line);
+  // writes line to output, which every worker shares
+  void print(const string &line);
+
+  int threads;
+  ostream output;
+  map<string, unique_ptr<CachedTrace>> traces;
+  bool stopping;
+  queue<BatchJob *> pending;
+  mutex batchMutex, outputMutex;
+  condition_variable jobReady, jobTaken;
+};
+
+#endif // BATCH_RUNNER_H
@@ -0,0 +1,52 @@
+#!/bin/sh
+# FILE: benchmark.sh
+# A Bautista, B Franco, E Mora
+# OS, Fall 2023, Transy U
+#
+# times babyOS's load, schedule, and page phases for every pager type and scheduler type on workloads written by babyOS-gen
+# from 10^3 to 10^7 references, and reports references per second for paging and for the whole run
+# run through make benchmark, BENCH_MAX_REFERENCES caps the largest workload and BENCH_DIR is where the workloads are kept
+# ex. make benchmark BENCH_MAX_REFERENCES=1000000
+#
+# Each workload is 1000 reference processes under zipf locality over BENCH_PAGES pages, paged into BENCH_FRAMES frames,
+# and is only generated once, so later runs time the same files
+#
+
+BENCH_MAX_REFERENCES=${BENCH_MAX_REFERENCES:-10000000}
+BENCH_DIR=${BENCH_DIR:-bench}
+BENCH_PAGES=256
+BENCH_FRAMES=16
+BENCH_BURST=1000
+
+mkdir -p "$BENCH_DIR" || exit 1
+printf "%-10s %-8s %-10s %10s %10s %10s %14s %14s\n" references pager scheduler load schedule page "page refs/s" "total refs/s"
+
+references=1000
+while [ "$references" -le "$BENCH_MAX_REFERENCES" ]; do
+  processes=$((references / BENCH_BURST))
+  workload="$BENCH_DIR/zipf$references.in"
+  # bursts are drawn around BENCH_BURST, so the exact number of references is taken from the report
+  if [ ! -f "$workload" ]; then
+    ./babyOS-gen --processes "$processes" --burst "$BENCH_BURST" --pages "$BENCH_PAGES" --locality zipf "$workload" || exit 1
+  fi
+
+  for pager in FIFO LRU MFU Random OPT WSClock PFF; do
+    for scheduler in FCFS SJF Priority RR; do
+      options=""
+      [ "$scheduler" = RR ] && options="--preemptive --quanta 10"
+      ./babyOS --pages "$BENCH_PAGES" --frames "$BENCH_FRAMES" --pagerType "$pager" --schedulerType "$scheduler" $options \
+        --report csv "$workload" > "$BENCH_DIR/report.csv" || exit 1
+      awk -F, -v pager="$pager" -v scheduler="$scheduler" '
+        $1 == "phase" { seconds[$2] = $10; total += $10 }
+        $1 == "total" { references = $4 }
+        END {
+          pageRate = seconds["page"] > 0 ? references / seconds["page"] : 0
+          totalRate = total > 0 ? references / total : 0
+          printf "%-10d %-8s %-10s %10.4f %10.4f %10.4f %14.0f %14.0f\n", references, pager, scheduler,
+            seconds["load"], seconds["schedule"], seconds["page"], pageRate, totalRate
+        }' "$BENCH_DIR/report.csv"
+    done
+  done
+  references=$((references * 10))
+done
+rm -f "$BENCH_DIR/report.csv"
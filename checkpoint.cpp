@@ -0,0 +1,161 @@
+// FILE: checkpoint.cpp
+// A Bautista, B Franco, E Mora
+// OS, Fall 2023, Transy U
+//
+//	implementation of --checkpoint and --resume
+//
+//	A snapshot is built in memory and written to fileName.tmp, which is flushed and fsync'd to disk before it is renamed over fileName,
+//	and the directory is fsync'd after the rename so that the rename itself is on disk too. rename replaces fileName in one step, so
+//	even after a crash fileName holds either the whole old snapshot or the whole new one, never a snapshot that was still being written
+//	The body is hashed into the header and checked before anything is restored from it, so a damaged snapshot is turned away rather
+//	than half restored
+//
+
+#include "checkpoint.h"
+#include <iostream>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace std;
+
+SnapshotHeader snapshotHeader(PagerPolicy policy, int frames, long long pages, int window, int tlbEntries, int tlbWays, int pageShift, bool global,
+                              const ProcessTable &table){
+  size_t count = table.size();
+  SnapshotHeader header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, SNAPSHOT_MAGIC, SNAPSHOT_MAGIC_SIZE);
+  header.version = SNAPSHOT_VERSION;
+  header.policy = policy;
+  header.frames = frames;
+  header.window = window;
+  header.tlbEntries = tlbEntries;
+  header.tlbWays = tlbWays;
+  header.pageShift = pageShift;
+  header.global = global;
+  header.pages = pages;
+  header.processCount = count;
+  header.traceHash = SNAPSHOT_HASH_START;
+  for(size_t i = 0; i < count; i++){
+    int32_t fields[] = {table.pid[i], table.arrival[i], table.burst[i], table.priority[i]};
+    header.traceHash = snapshotHash(fields, sizeof(fields), header.traceHash);
+    header.traceHash = snapshotHash(table.processAddresses(i), table.burst[i] * sizeof(int64_t), header.traceHash);
+    header.addressCount += table.burst[i];
+  }
+  return header;
+}
+
+Checkpointer::Checkpointer(const char *fileName, long long every, const SnapshotHeader &header, const Scheduler &scheduler,
+                           const ProcessTable &table) : table(table), shadow(scheduler){
+  this->fileName = fileName ? fileName : "";
+  this->every = every;
+  this->header = header;
+  sinceLast = total = 0;
+  resumed = false;
+  memset(&resumedHeader, 0, sizeof(resumedHeader));
+  shadow.start(table);
+}
+
+bool Checkpointer::resume(const char *fileName, Scheduler &scheduler){
+  FILE *file = fopen(fileName, "rb");
+  if(!file){
+    cout << "\tERROR: " << fileName << " could not be opened to resume from\n";
+    return false;
+  }
+  bool complete = fread(&resumedHeader, sizeof(resumedHeader), 1, file) == 1 &&
+    !memcmp(resumedHeader.magic, SNAPSHOT_MAGIC, SNAPSHOT_MAGIC_SIZE) && resumedHeader.version == SNAPSHOT_VERSION;
+  long headerEnd = ftell(file);
+  if(complete && fseek(file, 0, SEEK_END) == 0 && (uint64_t)(ftell(file) - headerEnd) == resumedHeader.bodySize){
+    fseek(file, headerEnd, SEEK_SET);
+    body.resize(resumedHeader.bodySize);
+    complete = fread(body.data(), 1, body.size(), file) == body.size() && snapshotHash(body.data(), body.size()) == resumedHeader.bodyHash;
+  }
+  else complete = false;
+  fclose(file);
+  if(!complete){
+    cout << "\tERROR: " << fileName << " is not a babyOS snapshot of version " << SNAPSHOT_VERSION << " or is truncated or corrupt\n";
+    return false;
+  }
+
+  const SnapshotHeader &saved = resumedHeader;
+  if(saved.processCount != header.processCount || saved.addressCount != header.addressCount || saved.traceHash != header.traceHash){
+    cout << "\tERROR: " << fileName << " was checkpointed from another input file\n";
+    return false;
+  }
+  if(saved.policy != header.policy || saved.frames != header.frames || saved.window != header.window || saved.tlbEntries != header.tlbEntries ||
+     saved.tlbWays != header.tlbWays || saved.pageShift != header.pageShift || saved.global != header.global || saved.pages != header.pages){
+    cout << "\tERROR: " << fileName << " can only be resumed with the " << PAGER_TYPE << ", " << FRAMES << ", " << PAGES << ", " << FRAME_SIZE << ", "
+         << WINDOW << ", " << TLB_ENTRIES << ", " << TLB_WAYS << ", and " << GLOBAL_FRAMES << " it was checkpointed with\n";
+    return false;
+  }
+
+  reader.open(body.data(), body.size());
+  if(!scheduler.restore(table, reader)){
+    cout << "\tERROR: " << fileName << " is corrupt, its schedule does not fit the processes of the input file\n";
+    return false;
+  }
+  resumedName = fileName;
+  shadow = scheduler;
+  total = saved.paged;
+  resumed = true;
+  return true;
+}
+
+bool Checkpointer::cursorsFit(const vector<long long> &cursor){
+  if(reader.failed || cursor.size() != table.size()) return false;
+  for(size_t i = 0; i < cursor.size(); i++){
+    if(cursor[i] < 0 || cursor[i] > table.burst[i]) return false;
+  }
+  return true;
+}
+
+bool Checkpointer::pagerRestored(bool fits){
+  if(!fits || reader.failed || !reader.finished()){
+    cout << "\tERROR: " << resumedName << " is corrupt, its pager state does not fit the input file and paging options\n";
+    return false;
+  }
+  return true;
+}
+
+SnapshotWriter &Checkpointer::begin(long long time){
+  shadowTimeline.clear();
+  shadow.run(shadowTimeline, time);
+  writer.buffer.clear();
+  shadow.save(writer);
+  header.time = time;
+  return writer;
+}
+
+void Checkpointer::commit(){
+  string temporary = fileName + ".tmp";
+  header.paged = total;
+  header.bodySize = writer.buffer.size();
+  header.bodyHash = snapshotHash(writer.buffer.data(), writer.buffer.size());
+  sinceLast = 0;
+
+  FILE *file = fopen(temporary.c_str(), "wb");
+  bool error = !file;
+  if(file){
+    error = fwrite(&header, sizeof(header), 1, file) != 1 || fwrite(writer.buffer.data(), 1, writer.buffer.size(), file) != writer.buffer.size();
+    // the snapshot has to be on disk before it replaces the one before it, or a crash could leave neither
+    if(!error && (fflush(file) != 0 || fsync(fileno(file)) != 0)) error = true;
+    if(fclose(file) != 0) error = true;
+  }
+  if(error || rename(temporary.c_str(), fileName.c_str()) != 0){
+    cout << "\tERROR: Could not write a checkpoint to " << fileName << ", the one before it is left in place\n";
+    remove(temporary.c_str());
+    return;
+  }
+  syncDirectory();
+}
+
+void Checkpointer::syncDirectory(){
+  size_t slash = fileName.rfind('/');
+  string directory = slash == string::npos ? "." : slash == 0 ? "/" : fileName.substr(0, slash);
+  int fd = open(directory.c_str(), O_RDONLY | O_DIRECTORY);
+  if(fd == -1 || fsync(fd) != 0){
+    cout << "\tERROR: Could not sync " << directory << ", the checkpoint written to " << fileName << " may not survive a crash\n";
+  }
+  if(fd != -1) close(fd);
+}
@@ -0,0 +1,122 @@
+// FILE: checkpoint.h
+// A Bautista, B Franco, E Mora
+// OS, Fall 2023, Transy U
+//
+//	interface for --checkpoint and --resume, which let a long run be picked up again after it is stopped
+//	A snapshot is laid out as
+//		SnapshotHeader
+//		the scheduler's state as of the snapshot's time (Scheduler::save)
+//		each process's address cursor and finished stats, then the state of every pager still in use (pageSchedule, pageScheduleGlobal)
+//	Checkpointer keeps a second Scheduler a step behind the paging, so that at each checkpoint it can be run up to the time
+//	on the timeline the pager has reached and saved as it stands there, which is cheap next to the paging it follows
+//	A snapshot is only ever resumed by a run that pages the same trace the same way, which the header records, but the scheduler
+//	may be different, so one warmed up snapshot can be resumed under several schedulers to compare them without paging the prefix again
+//
+
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include "babyOS.h"
+#include "pagerEngine.h"
+#include "scheduler.h"
+#include "snapshot.h"
+#include "traceFile.h"
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+#define SNAPSHOT_MAGIC "BABYSNP"
+#define SNAPSHOT_MAGIC_SIZE 8
+#define SNAPSHOT_VERSION 2
+
+struct SnapshotHeader{
+  char magic[SNAPSHOT_MAGIC_SIZE];
+  uint32_t version;
+  // how the run paged, which a resumed run has to match, global is 1 for --global-frames
+  int32_t policy, frames, window, tlbEntries, tlbWays, pageShift, global;
+  int64_t pages;
+  // the trace, traceHash covers every process's pid, arrival, burst, priority, and addresses, so it is the same for a text trace and its --convert
+  uint64_t processCount, addressCount, traceHash;
+  // the time on the timeline the snapshot was taken at and how many references had been paged by then
+  int64_t time, paged;
+  uint64_t bodySize, bodyHash;
+};
+
+// returns the header a snapshot of a run paging the processes of table with these options would have, its time and body left 0
+SnapshotHeader snapshotHeader(PagerPolicy policy, int frames, long long pages, int window, int tlbEntries, int tlbWays, int pageShift, bool global,
+                              const ProcessTable &table);
+
+class Checkpointer{
+ public:
+  // checkpoints a run described by header to fileName every every references, or never if fileName is NULL
+  // scheduler is the run's own, which has not yet scheduled the processes of table
+  Checkpointer(const char *fileName, long long every, const SnapshotHeader &header, const Scheduler &scheduler, const ProcessTable &table);
+
+  // reads the snapshot fileName, checks that it was taken by a run paging this trace the same way, and restores scheduler from it
+  // returns false and prints the error if it can't be resumed
+  bool resume(const char *fileName, Scheduler &scheduler);
+
+  bool resuming(){
+    return resumed;
+  }
+
+  // the pager's part of the snapshot resume read, for pageSchedule or pageScheduleGlobal to restore from
+  SnapshotReader &pagerState(){
+    return reader;
+  }
+
+  // true if the address cursors read from pagerState are one for each process, each within its burst
+  bool cursorsFit(const vector<long long> &cursor);
+
+  // called once the pager has been restored from pagerState, fits being false if what it read didn't fit it
+  // returns false and prints the error if it didn't fit, the snapshot ran out, or it holds more than the pager read
+  bool pagerRestored(bool fits);
+
+  // the time on the timeline and the number of references paged when the resumed snapshot was taken
+  long long resumedTime(){
+    return resumedHeader.time;
+  }
+  long long resumedPaged(){
+    return resumedHeader.paged;
+  }
+
+  // returns how many of the next count references can be paged before a checkpoint is due
+  long long chunk(long long count){
+    return fileName.empty() || count < every - sinceLast ? count : every - sinceLast;
+  }
+
+  // counts count references as paged, returns true if a checkpoint is due
+  bool paged(long long count){
+    total += count;
+    sinceLast += count;
+    return !fileName.empty() && sinceLast >= every;
+  }
+
+  // starts a snapshot as of time on the timeline, writing the scheduler's state as it stands then
+  // the caller writes the pager's state to the writer it returns and then calls commit
+  SnapshotWriter &begin(long long time);
+
+  // writes the snapshot out, the last one is only replaced once the new one has been written in full and synced to disk, so a run
+  // that is killed or a machine that crashes part way through a checkpoint still leaves the one before it
+  // A checkpoint that can't be written is reported and the run goes on
+  void commit();
+
+ private:
+  // fsyncs the directory fileName is in, so that the rename commit made is on disk as well
+  void syncDirectory();
+
+  string fileName, resumedName;
+  long long every, sinceLast, total;
+  SnapshotHeader header, resumedHeader;
+  const ProcessTable &table;
+  Scheduler shadow;
+  vector<ScheduleSlice> shadowTimeline;
+  SnapshotWriter writer;
+  vector<char> body;
+  SnapshotReader reader;
+  bool resumed;
+};
+
+#endif // CHECKPOINT_H
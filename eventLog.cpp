@@ -0,0 +1,33 @@
+// FILE: eventLog.cpp
+// A Bautista, B Franco, E Mora
+// OS, Fall 2023, Transy U
+//
+//	implementation of babyOS's leveled paging log
+//
+
+#include "eventLog.h"
+
+using namespace std;
+
+LogLevel logLevelFromName(string_view logLevel){
+  if(logLevel == PROCESS_LEVEL) return PROCESS_LOG;
+  if(logLevel == REFERENCE_LEVEL) return REFERENCE_LOG;
+  return SUMMARY_LOG;
+}
+
+EventLog::EventLog(LogLevel level, int sample, ostream &out) : out(out){
+  this->level = level;
+  this->sample = sample;
+  buffer = new char[LOG_BUFFER_SIZE];
+  used = 0;
+}
+
+EventLog::~EventLog(){
+  flush();
+  delete[] buffer;
+}
+
+void EventLog::flush(){
+  if(used) out.write(buffer, used);
+  used = 0;
+}
@@ -0,0 +1,95 @@
+// FILE: eventLog.h
+// A Bautista, B Franco, E Mora
+// OS, Fall 2023, Transy U
+//
+//	interface for babyOS's leveled paging log, which replaces writing each verbose event through an ostream
+//	Each level prints everything the levels before it print
+//		summary		each process's page faults, what babyOS always printed
+//		process		each process's hits and evictions, and for schedulers other than FCFS every slice as it is paged
+//		reference	every reference, what --verbose printed
+//	Events are formatted with to_chars straight into a LOG_BUFFER_SIZE buffer owned by one thread, which is only written
+//	to its ostream when it fills or is flushed, so a reference costs a few stores rather than a trip through the ostream
+//	With --logSample N only every Nth reference of each process is printed, starting with its first
+//
+
+#ifndef EVENT_LOG_H
+#define EVENT_LOG_H
+
+#include "babyOS.h"
+#include <charconv>
+#include <cstring>
+#include <ostream>
+#include <string_view>
+
+using namespace std;
+
+#define LOG_BUFFER_SIZE (1 << 20)
+// longest a single number can be when formatted
+#define LOG_NUMBER_MAX 24
+
+enum LogLevel{
+  SUMMARY_LOG,
+  PROCESS_LOG,
+  REFERENCE_LOG
+};
+
+// returns the level named by logLevel, which inputErrorCheck has already made sure is valid
+LogLevel logLevelFromName(string_view logLevel);
+
+class EventLog{
+ public:
+  // events at or below level are written to out, references only every sample of them
+  EventLog(LogLevel level, int sample, ostream &out);
+  // flushes whatever is left
+  ~EventLog();
+
+  // true if events at level should be printed
+  bool logs(LogLevel level){
+    return level <= this->level;
+  }
+  // true if the reference numbered reference, counting a process's first reference as 1, should be printed
+  bool sampled(long long reference){
+    return sample == 1 || (reference - 1) % sample == 0;
+  }
+
+  EventLog &operator<<(string_view text){
+    if(used + text.size() > LOG_BUFFER_SIZE){
+      flush();
+      if(text.size() > LOG_BUFFER_SIZE){
+        out.write(text.data(), text.size());
+        return *this;
+      }
+    }
+    memcpy(buffer + used, text.data(), text.size());
+    used += text.size();
+    return *this;
+  }
+  EventLog &operator<<(const char *text){
+    return *this << string_view(text);
+  }
+  EventLog &operator<<(char c){
+    if(used == LOG_BUFFER_SIZE) flush();
+    buffer[used++] = c;
+    return *this;
+  }
+  EventLog &operator<<(long long number){
+    if(used + LOG_NUMBER_MAX > LOG_BUFFER_SIZE) flush();
+    used = to_chars(buffer + used, buffer + LOG_BUFFER_SIZE, number).ptr - buffer;
+    return *this;
+  }
+  EventLog &operator<<(int number){
+    return *this << (long long)number;
+  }
+
+  // writes the buffer to out, anything printed to out directly has to wait until the log has been flushed to stay in order
+  void flush();
+
+ private:
+  LogLevel level;
+  int sample;
+  ostream &out;
+  char *buffer;
+  size_t used;
+};
+
+#endif // EVENT_LOG_H
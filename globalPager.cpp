@@ -0,0 +1,161 @@
+// FILE: globalPager.cpp
+// A Bautista, B Franco, E Mora
+// OS, Fall 2023, Transy U
+//
+//	implementation of --global-frames
+//
+//	The hash table is linear probing over at least twice as many slots as there are frames, so it is never more than half full
+//	and a lookup rarely probes more than a slot or two. Evicted pages are erased by shifting the rest of their run back
+//	rather than leaving tombstones, so lookups never slow down over a long run
+//
+
+#include "globalPager.h"
+#include "profiler.h"
+#include <cstring>
+
+using namespace std;
+
+GlobalPager::GlobalPager(PagerPolicy policy, int frames, int window, size_t processes)
+  : order(policy, frames, 1, window), frameProcess(frames), framePage(frames){
+  PagerStats empty;
+  memset(&empty, 0, sizeof(empty));
+  stats.assign(processes, empty);
+
+  size_t slots = 1;
+  while(slots < 2 * (size_t)frames) slots <<= 1;
+  mask = slots - 1;
+  slotProcess.resize(slots);
+  slotFrame.assign(slots, NO_FRAME);
+  slotPage.resize(slots);
+}
+
+size_t GlobalPager::home(int process, long long page){
+  // the finalizer from splitmix64, so neighbouring pages and processes land far apart
+  uint64_t key = (uint64_t)page * 0x9E3779B97F4A7C15ULL ^ (uint64_t)process;
+  key ^= key >> 30;
+  key *= 0xBF58476D1CE4E5B9ULL;
+  key ^= key >> 27;
+  key *= 0x94D049BB133111EBULL;
+  key ^= key >> 31;
+  return key & mask;
+}
+
+size_t GlobalPager::findSlot(int process, long long page){
+  size_t slot = home(process, page);
+  while(slotFrame[slot] != NO_FRAME && (slotPage[slot] != page || slotProcess[slot] != process)) slot = (slot + 1) & mask;
+  return slot;
+}
+
+void GlobalPager::eraseSlot(size_t slot){
+  size_t next = slot;
+  while(true){
+    next = (next + 1) & mask;
+    if(slotFrame[next] == NO_FRAME) break;
+    size_t wanted = home(slotProcess[next], slotPage[next]);
+    // next can move back into slot if slot lies cyclically between where it hashed to and where it is
+    if(((next - wanted) & mask) >= ((next - slot) & mask)){
+      slotProcess[slot] = slotProcess[next];
+      slotPage[slot] = slotPage[next];
+      slotFrame[slot] = slotFrame[next];
+      slot = next;
+    }
+  }
+  slotFrame[slot] = NO_FRAME;
+}
+
+template<PagerPolicy Policy>
+bool GlobalPager::referenceAs(int process, long long page, int &frame, long long &victim, int &victimProcess, long long nextUse){
+  PagerStats &processStats = stats[process];
+  bool evicting;
+  processStats.references++;
+  victim = NO_PAGE;
+  victimProcess = process;
+
+  size_t slot;
+  {
+    ProfileScope scope(PAGE_TABLE_STAGE);
+    slot = findSlot(process, page);
+  }
+  if(slotFrame[slot] != NO_FRAME){
+    frame = slotFrame[slot];
+    processStats.hits++;
+    order.touchFrameAs<Policy>(frame, nextUse);
+    return false;
+  }
+
+  processStats.faults++;
+  frame = order.claimFrameAs<Policy>(evicting, nextUse);
+  if(evicting){
+    victim = framePage[frame];
+    victimProcess = frameProcess[frame];
+    processStats.evictions++;
+    if(victimProcess != process) processStats.steals++;
+    eraseSlot(findSlot(victimProcess, victim));
+    // erasing may have shifted the empty slot the new page was going into
+    slot = findSlot(process, page);
+  }
+  slotProcess[slot] = process;
+  slotPage[slot] = page;
+  slotFrame[slot] = frame;
+  frameProcess[frame] = process;
+  framePage[frame] = page;
+  return true;
+}
+
+template<PagerPolicy Policy, bool Logged>
+static void pageGlobalSliceAs(GlobalPager &pager, const ProcessTable &table, int process, const int64_t *addresses, long long count,
+                              const long long *nextUse, int pageShift, EventLog &log){
+  ProfileScope scope(PAGE_STAGE);
+  for(long long t = 0; t < count; t++){
+    long long address = addresses[t], page = address >> pageShift, victim;
+    int frame, victimProcess;
+    bool fault = pager.referenceAs<Policy>(process, page, frame, victim, victimProcess, Policy == OPT_POLICY ? nextUse[t] : NO_NEXT_USE);
+    if constexpr(Logged){
+      if(log.sampled(pager.stats[process].references)){
+        log << '\t' << PID_FORM << table.pid[process] << " address " << address << " (page " << page << "): ";
+        if(!fault) log << "hit in frame " << frame << '\n';
+        else if(victim == NO_PAGE) log << "page fault, loaded into free frame " << frame << '\n';
+        else if(victimProcess == process) log << "page fault, replaced page " << victim << " in frame " << frame << '\n';
+        else log << "page fault, stole frame " << frame << " from page " << victim << " of " << PID_FORM << table.pid[victimProcess] << '\n';
+      }
+    }
+  }
+}
+
+// every instantiation, indexed [policy][logged] in the order of PagerPolicy, --global-frames never pages with PFF
+static const GlobalSliceKernel globalKernelTable[][2] = {
+  {pageGlobalSliceAs<FIFO_POLICY, false>, pageGlobalSliceAs<FIFO_POLICY, true>},
+  {pageGlobalSliceAs<LRU_POLICY, false>, pageGlobalSliceAs<LRU_POLICY, true>},
+  {pageGlobalSliceAs<MFU_POLICY, false>, pageGlobalSliceAs<MFU_POLICY, true>},
+  {pageGlobalSliceAs<RANDOM_POLICY, false>, pageGlobalSliceAs<RANDOM_POLICY, true>},
+  {pageGlobalSliceAs<OPT_POLICY, false>, pageGlobalSliceAs<OPT_POLICY, true>},
+  {pageGlobalSliceAs<WSCLOCK_POLICY, false>, pageGlobalSliceAs<WSCLOCK_POLICY, true>},
+  {NULL, NULL}
+};
+
+GlobalSliceKernel globalSliceKernel(PagerPolicy policy, bool logged){
+  return globalKernelTable[policy][logged];
+}
+
+void GlobalPager::save(SnapshotWriter &out){
+  order.save(out);
+  out.put(frameProcess);
+  out.put(framePage);
+  out.put(slotProcess);
+  out.put(slotFrame);
+  out.put(slotPage);
+  out.put(stats);
+}
+
+bool GlobalPager::restore(SnapshotReader &in){
+  size_t sizes[] = {frameProcess.size(), framePage.size(), slotProcess.size(), slotFrame.size(), slotPage.size(), stats.size()};
+  bool fits = order.restore(in);
+  in.get(frameProcess);
+  in.get(framePage);
+  in.get(slotProcess);
+  in.get(slotFrame);
+  in.get(slotPage);
+  in.get(stats);
+  size_t restoredSizes[] = {frameProcess.size(), framePage.size(), slotProcess.size(), slotFrame.size(), slotPage.size(), stats.size()};
+  return fits && !in.failed && !memcmp(sizes, restoredSizes, sizeof(sizes));
+}
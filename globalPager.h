@@ -0,0 +1,72 @@
+// FILE: globalPager.h
+// A Bautista, B Franco, E Mora
+// OS, Fall 2023, Transy U
+//
+//	interface for --global-frames, where every process competes for one pool of --frames frames instead of getting its own
+//	A process's fault may take a frame from any process, which counts as a steal for the process that faulted
+//	Which page of which process is in each frame is kept in one open addressing hash table keyed on (process, page), which only
+//	ever holds the resident pages so it is sized once from the number of frames and never grows
+//	The replacement order is a PagerEngine's, so every --pagerType chooses its victim exactly as it does per process, save PFF whose
+//	resident sets are per process by definition and which --global-frames doesn't accept
+//	A finished process's pages stay resident until they are replaced, the same as the pages of a process that is waiting
+//
+
+#ifndef GLOBAL_PAGER_H
+#define GLOBAL_PAGER_H
+
+#include "babyOS.h"
+#include "eventLog.h"
+#include "pagerEngine.h"
+#include "traceFile.h"
+#include <stdint.h>
+#include <vector>
+
+using namespace std;
+
+class GlobalPager{
+ public:
+  // a pool of frames frames shared by processes processes, numbered 0 to processes - 1, window is WSClock's working set window
+  GlobalPager(PagerPolicy policy, int frames, int window, size_t processes);
+
+  // references page of process, returns true if it faulted
+  // frame is set to the frame the page is in afterwards, victim to the page that was evicted for it or NO_PAGE and victimProcess to its owner
+  // nextUse is when page is next referenced by process for OPT, counted in the same time units across every process
+  // compiled for one policy, which has to be the pager's, and only instantiated in globalPager.cpp for the kernels of globalSliceKernel
+  template<PagerPolicy Policy>
+  bool referenceAs(int process, long long page, int &frame, long long &victim, int &victimProcess, long long nextUse);
+
+  // writes which page of which process is in each frame, the replacement order, and stats to out, restore reads them back
+  // into a pager made with the same policy, frames, window, and processes
+  // restore returns false if in ran out or what it held doesn't fit this pager's frames and processes
+  void save(SnapshotWriter &out);
+  bool restore(SnapshotReader &in);
+
+  // each process's paging stats
+  vector<PagerStats> stats;
+
+ private:
+  // the slot process's page is in, or the empty slot it would go in
+  size_t findSlot(int process, long long page);
+  // the slot a key hashes to before probing
+  size_t home(int process, long long page);
+  // empties slot, shifting back the slots after it that probed past it so that no lookup is cut short
+  void eraseSlot(size_t slot);
+
+  PagerEngine order;
+  vector<int> frameProcess;
+  vector<long long> framePage;
+  // the hash table, slotFrame is NO_FRAME for an empty slot
+  size_t mask;
+  vector<int> slotProcess, slotFrame;
+  vector<long long> slotPage;
+};
+
+// pages the count addresses starting at addresses of the process at index process in table with pager, logging each sampled
+// reference at REFERENCE_LOG in the logged kernels, nextUse holds each address's next use for OPT and is not read for any other policy
+typedef void (*GlobalSliceKernel)(GlobalPager &pager, const ProcessTable &table, int process, const int64_t *addresses, long long count,
+                                  const long long *nextUse, int pageShift, EventLog &log);
+
+// returns the kernel compiled for policy, logged picks the one that logs at REFERENCE_LOG, so a run picks it once like pagerKernels
+GlobalSliceKernel globalSliceKernel(PagerPolicy policy, bool logged);
+
+#endif // GLOBAL_PAGER_H
@@ -0,0 +1,68 @@
+// FILE: inputParse.cpp
+// A Bautista, B Franco, E Mora
+// OS, Fall 2023, Transy U
+//
+//	babyOS's input file error checks, built on the parsing layer in inputParse.h
+//	They live in a unit of their own rather than in the driver so that the loaders and validationBench link the same checks
+//
+
+#include "inputParse.h"
+#include "profiler.h"
+#include <iostream>
+
+using namespace std;
+
+bool idErrorCheck(string_view fileInput, int &pid){
+  bool error = false;
+  if(fileInput.find(PID_FORM) != 0 || fileInput.length() < 3){
+    cout << "\tERROR: Process id " << fileInput << " is not of form " << PID_FORM << "#\n";
+    error = true;
+  }
+  else if(parseInteger(fileInput.substr(2), pid) != PARSE_OK || pid < 0){
+    cout << "\tERROR: Process id " << fileInput << " must be a non-negative integer\n";
+    error = true;
+  }
+  return error;
+}
+
+bool loadErrorCheck(int pid, string_view arrival, string_view burst, string_view priority, PCB &block){
+  bool error = false;
+  if(parseInteger(arrival, block.arrival) != PARSE_OK || block.arrival < 0){
+    cout << "\tERROR: Arrival time of " << PID_FORM << pid << " must be a non-negative integer\n";
+    error = true;
+  }
+  if(parseInteger(burst, block.burst) != PARSE_OK || block.burst <= 0){
+    cout << "\tERROR: CPU burst of " << PID_FORM << pid << " must be a non-negative integer\n";
+    error = true;
+  }
+  if(parseInteger(priority, block.priority) != PARSE_OK || (block.priority > MAX_PRIORITY || block.priority < MIN_PRIORITY)){
+    cout << "\tERROR: Priority of " << PID_FORM << pid << " must be an integer from " << MIN_PRIORITY << " to " << MAX_PRIORITY << "\n";
+    error = true;
+  }
+  return error;
+}
+
+bool addressErrorCheck(int pid,int pageSize, long long pages, string_view address, long long &value){
+  ProfileScope scope(ADDRESS_CHECK_STAGE);
+  ParseError result = parseInteger(address, value);
+  if(result == PARSE_OUT_OF_RANGE){
+    cout << "\tERROR: Address " << address << " of " << PID_FORM << pid << " is too large to be an address\n";
+    return true;
+  }
+  else if(result != PARSE_OK || value < 0){
+    cout << "\tERROR: Address " << address << " of " << PID_FORM << pid << " must be a non-negative integer\n";
+    return true;  
+  }
+  // check if a process's address is possible within given frames and size
+  else if((value/pageSize) >= pages){
+    cout << "\tERROR: Address " << address << " of " << PID_FORM << pid << " cannot exist within " << pages << " " << pageSize << " byte pages\n";
+    return true;
+  }
+  return false;
+}
+
+bool integerCheck(string_view integerString){
+  int integer;
+  // prepended zeros and a leading '-' are accepted by parseInteger, anything that doesn't fit in an int is not an integer here
+  return parseInteger(integerString, integer) == PARSE_OK;
+}
@@ -0,0 +1,53 @@
+// FILE: inputParse.h
+// A Bautista, B Franco, E Mora
+// OS, Fall 2023, Transy U
+//
+//	allocation free parsing layer underneath babyOS's error checking functions
+//	Each value is parsed with from_chars over a string_view in a single pass, so the error checks no longer
+//	build comparison strings or copy their arguments, and the parsed value is handed back alongside the
+//	result so callers never have to run atoi over the same characters again
+//
+
+#ifndef INPUT_PARSE_H
+#define INPUT_PARSE_H
+
+#include "babyOS.h"
+#include <charconv>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+using namespace std;
+
+enum ParseError{
+  PARSE_OK,
+  PARSE_NOT_INTEGER,
+  PARSE_OUT_OF_RANGE
+};
+
+// parses text as a base ten integer of value's type, prepended zeros and a leading '-' are allowed just as integerCheck always allowed them
+// value is only meaningful if PARSE_OK is returned
+template<class Integer>
+inline ParseError parseInteger(string_view text, Integer &value){
+  const char *first = text.data();
+  const char *last = first + text.size();
+  if(first == last) return PARSE_NOT_INTEGER;
+  from_chars_result result = from_chars(first, last, value);
+  if(result.ec == errc::result_out_of_range) return PARSE_OUT_OF_RANGE;
+  if(result.ec != errc() || result.ptr != last) return PARSE_NOT_INTEGER;
+  return PARSE_OK;
+}
+
+// splits a comma separated list such as "FIFO,LRU" or "3,8,16" into its items, an empty item is kept so it can be reported
+inline vector<string_view> splitList(string_view list){
+  vector<string_view> items;
+  size_t start = 0, comma;
+  while((comma = list.find(',', start)) != string_view::npos){
+    items.push_back(list.substr(start, comma - start));
+    start = comma + 1;
+  }
+  items.push_back(list.substr(start));
+  return items;
+}
+
+#endif // INPUT_PARSE_H
@@ -0,0 +1,148 @@
+// FILE: pageTable.cpp
+// A Bautista, B Franco, E Mora
+// OS, Fall 2023, Transy U
+//
+//	implementation of the page table and TLB behind PagerEngine
+//
+//	PageTable's nodes are carved out of one vector rather than allocated one by one, clearing it between processes only
+//	shrinks the vector back to the root so its capacity is reused, and since the root always sits at index 0 an interior
+//	entry of 0 can mean that the child doesn't exist
+//
+
+#include "pageTable.h"
+#include <algorithm>
+
+using namespace std;
+
+PageTable::PageTable(long long pages){
+  int bits = 0;
+  while(bits < 62 && (1LL << bits) < pages) bits++;
+  levels = 1;
+  while(bits > levels * PAGE_TABLE_BITS) levels++;
+  rootSize = 1 << (bits - (levels - 1) * PAGE_TABLE_BITS);
+  clear();
+}
+
+void PageTable::map(long long page, int frame){
+  size_t node = 0;
+  int shift = (levels - 1) * PAGE_TABLE_BITS;
+  size_t index = page >> shift;
+  if(index >= (size_t)rootSize) return;
+  for(int level = levels - 1; level > 0; level--){
+    if(!entries[node + index]){
+      int child = newNode(PAGE_TABLE_NODE, level == 1 ? NO_FRAME : 0);
+      entries[node + index] = child;
+    }
+    node = entries[node + index];
+    shift -= PAGE_TABLE_BITS;
+    index = (page >> shift) & (PAGE_TABLE_NODE - 1);
+  }
+  entries[node + index] = frame;
+}
+
+void PageTable::unmap(long long page){
+  size_t node = 0;
+  int shift = (levels - 1) * PAGE_TABLE_BITS;
+  size_t index = page >> shift;
+  if(index >= (size_t)rootSize) return;
+  for(int level = levels - 1; level > 0; level--){
+    if(!entries[node + index]) return;
+    node = entries[node + index];
+    shift -= PAGE_TABLE_BITS;
+    index = (page >> shift) & (PAGE_TABLE_NODE - 1);
+  }
+  entries[node + index] = NO_FRAME;
+}
+
+void PageTable::clear(){
+  entries.clear();
+  newNode(rootSize, levels == 1 ? NO_FRAME : 0);
+}
+
+void PageTable::save(SnapshotWriter &out){
+  out.put(entries);
+}
+
+void PageTable::restore(SnapshotReader &in){
+  in.get(entries);
+}
+
+int PageTable::newNode(int size, int value){
+  int node = entries.size();
+  entries.resize(entries.size() + size, value);
+  return node;
+}
+
+Tlb::Tlb(int entries, int ways){
+  this->ways = ways;
+  sets = entries ? entries / ways : 0;
+  pages.resize(entries);
+  lastUse.resize(entries);
+  frames.resize(entries);
+  flush();
+}
+
+bool Tlb::lookup(long long page, int &frame){
+  int first = (page % sets) * ways;
+  for(int way = first; way < first + ways; way++){
+    if(pages[way] == page){
+      lastUse[way] = ++clock;
+      frame = frames[way];
+      return true;
+    }
+  }
+  return false;
+}
+
+void Tlb::insert(long long page, int frame){
+  int first = (page % sets) * ways, victim = first;
+  // an empty way has a lastUse of 0 so it is always picked before any entry in use
+  for(int way = first + 1; way < first + ways; way++){
+    if(lastUse[way] < lastUse[victim]) victim = way;
+  }
+  pages[victim] = page;
+  frames[victim] = frame;
+  lastUse[victim] = ++clock;
+}
+
+void Tlb::repeat(long long page, long long count){
+  int first = (page % sets) * ways;
+  clock += count;
+  for(int way = first; way < first + ways; way++){
+    if(pages[way] == page){
+      lastUse[way] = clock;
+      return;
+    }
+  }
+}
+
+void Tlb::invalidate(long long page){
+  int first = (page % sets) * ways;
+  for(int way = first; way < first + ways; way++){
+    if(pages[way] == page){
+      pages[way] = NO_PAGE;
+      lastUse[way] = 0;
+      return;
+    }
+  }
+}
+
+void Tlb::flush(){
+  fill(pages.begin(), pages.end(), (long long)NO_PAGE);
+  fill(lastUse.begin(), lastUse.end(), 0LL);
+  clock = 0;
+}
+
+void Tlb::save(SnapshotWriter &out){
+  out.put(pages);
+  out.put(lastUse);
+  out.put(frames);
+  out.put(clock);
+}
+
+void Tlb::restore(SnapshotReader &in){
+  in.get(pages);
+  in.get(lastUse);
+  in.get(frames);
+  in.get(clock);
+}
@@ -0,0 +1,109 @@
+// FILE: pageTable.h
+// A Bautista, B Franco, E Mora
+// OS, Fall 2023, Transy U
+//
+//	interface for the page table and TLB behind PagerEngine
+//	PageTable is a radix tree of PAGE_TABLE_BITS bits per level, as many levels as --pages needs, whose nodes are only made when
+//	a page under them is mapped, so memory follows the pages a process actually touches rather than the size of its address space
+//	With the default 8 pages it is a single 8 entry level, the same flat array the engine used to keep
+//	Tlb is a set associative translation lookaside buffer of --tlb-entries entries in --tlb-ways way sets with LRU replacement
+//	within each set, a page's set is its page number modulo the number of sets
+//
+
+#ifndef PAGE_TABLE_H
+#define PAGE_TABLE_H
+
+#include "babyOS.h"
+#include "snapshot.h"
+#include <vector>
+
+using namespace std;
+
+#define NO_FRAME -1
+#define NO_PAGE -1
+#define PAGE_TABLE_BITS 10
+#define PAGE_TABLE_NODE (1 << PAGE_TABLE_BITS)
+
+class PageTable{
+ public:
+  // a table for page numbers 0 to pages - 1
+  PageTable(long long pages);
+
+  // returns the frame page is mapped to, NO_FRAME if it isn't, never allocates
+  int find(long long page){
+    size_t node = 0;
+    int shift = (levels - 1) * PAGE_TABLE_BITS;
+    // the root is indexed by whatever bits are left above the lower levels, every level below it by PAGE_TABLE_BITS
+    size_t index = page >> shift;
+    // a page outside the table, which the loaders never hand out, is never mapped rather than indexed past the root
+    if(index >= (size_t)rootSize) return NO_FRAME;
+    for(int level = levels - 1; level > 0; level--){
+      int child = entries[node + index];
+      if(!child) return NO_FRAME;
+      node = child;
+      shift -= PAGE_TABLE_BITS;
+      index = (page >> shift) & (PAGE_TABLE_NODE - 1);
+    }
+    return entries[node + index];
+  }
+
+  // maps page to frame, making any nodes on the way that don't exist yet, a page outside the table is left unmapped
+  void map(long long page, int frame);
+
+  // maps page to NO_FRAME, its nodes are kept until clear
+  void unmap(long long page);
+
+  // unmaps every page and frees every node but the root, the memory itself is kept for the next process
+  void clear();
+
+  // writes every node to out, restore reads them back into a table made for the same number of pages
+  void save(SnapshotWriter &out);
+  void restore(SnapshotReader &in);
+
+ private:
+  // allocates a node of size entries set to value, returns its index into entries
+  int newNode(int size, int value);
+
+  int levels, rootSize;
+  // every node back to back, the root first, an interior entry is the index of its child node or 0 if it has none
+  // and a leaf entry is a frame or NO_FRAME
+  vector<int> entries;
+};
+
+class Tlb{
+ public:
+  // a TLB of entries entries in ways way sets, entries 0 disables it
+  Tlb(int entries, int ways);
+
+  bool enabled(){
+    return sets != 0;
+  }
+
+  // returns true and sets frame if page is cached
+  bool lookup(long long page, int &frame);
+
+  // caches page's frame, evicting the least recently used entry in its set if it is full
+  void insert(long long page, int frame);
+
+  // counts count more lookups of page, which has to be the page last looked up or inserted, leaving the TLB as count hits would
+  void repeat(long long page, long long count);
+
+  // drops page if it is cached, for when it is evicted from its frame
+  void invalidate(long long page);
+
+  // drops every entry
+  void flush();
+
+  // writes every entry to out, restore reads them back into a TLB made with the same entries and ways
+  void save(SnapshotWriter &out);
+  void restore(SnapshotReader &in);
+
+ private:
+  int sets, ways;
+  long long clock;
+  // entry [set * ways + way]
+  vector<long long> pages, lastUse;
+  vector<int> frames;
+};
+
+#endif // PAGE_TABLE_H
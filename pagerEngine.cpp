@@ -0,0 +1,589 @@
+// FILE: pagerEngine.cpp
+// A Bautista, B Franco, E Mora
+// OS, Fall 2023, Transy U
+//
+//	implementation of babyOS's page replacement engine
+//
+//	Frames are filled in order 0, 1, 2, ... while there are free ones, so usedFrames doubles as the next free frame.
+//	MFU's heap holds every used frame with the most frequently used page on top, a page's use count starts at 1 when it
+//	is loaded and only grows while it stays resident
+//	OPT shares the heap with the page used furthest in the future on top, a hit only ever pushes its frame's next use later
+//	PFF is the one policy that gives frames back, so it keeps a stack of free frames besides the ones never used yet
+//
+
+#include "pagerEngine.h"
+#include "profiler.h"
+#include <cstring>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+PagerPolicy policyFromName(string_view pagerType){
+  if(pagerType == LEAST_RECENT_USED) return LRU_POLICY;
+  if(pagerType == MOST_FREQUENT_USED) return MFU_POLICY;
+  if(pagerType == RANDOM) return RANDOM_POLICY;
+  if(pagerType == OPTIMAL) return OPT_POLICY;
+  if(pagerType == WORKING_SET_CLOCK) return WSCLOCK_POLICY;
+  if(pagerType == PAGE_FAULT_FREQUENCY) return PFF_POLICY;
+  return FIFO_POLICY;
+}
+
+const char *policyName(PagerPolicy policy){
+  if(policy == LRU_POLICY) return LEAST_RECENT_USED;
+  if(policy == MFU_POLICY) return MOST_FREQUENT_USED;
+  if(policy == RANDOM_POLICY) return RANDOM;
+  if(policy == OPT_POLICY) return OPTIMAL;
+  if(policy == WSCLOCK_POLICY) return WORKING_SET_CLOCK;
+  if(policy == PFF_POLICY) return PAGE_FAULT_FREQUENCY;
+  return FIRST_IN_FIRST_OUT;
+}
+
+PagerEngine::PagerEngine(PagerPolicy policy, int frames, long long pages, int window, int tlbEntries, int tlbWays)
+  : pageTable(pages), ahead(policy == OPT_POLICY ? pages : 1), tlb(tlbEntries, tlbWays), framePage(frames){
+  this->policy = policy;
+  this->frames = frames;
+  this->window = window;
+  usedFrames = 0;
+  if(policy == LRU_POLICY || policy == PFF_POLICY){
+    previous.resize(frames);
+    next.resize(frames);
+  }
+  if(policy == MFU_POLICY || policy == OPT_POLICY){
+    heap.resize(frames);
+    heapPosition.resize(frames);
+  }
+  if(policy == MFU_POLICY){
+    useCount.resize(frames);
+    loadTime.resize(frames);
+  }
+  else if(policy == OPT_POLICY){
+    frameNextUse.resize(frames);
+  }
+  if(policy == WSCLOCK_POLICY || policy == PFF_POLICY){
+    lastUse.resize(frames);
+  }
+  if(policy == WSCLOCK_POLICY){
+    referencedBit.resize(frames);
+  }
+  reset();
+}
+
+void PagerEngine::reset(){
+  pageTable.clear();
+  if(tlb.enabled()) tlb.flush();
+  usedFrames = 0;
+  ringNext = 0;
+  head = tail = NO_FRAME;
+  clock = 0;
+  randomState = RANDOM_SEED;
+  hand = 0;
+  freeFrames.clear();
+  released.clear();
+  lastFault = 0;
+  memset(&stats, 0, sizeof(stats));
+}
+
+void PagerEngine::save(SnapshotWriter &out){
+  out.put(usedFrames);
+  pageTable.save(out);
+  tlb.save(out);
+  out.put(framePage);
+  out.put(ringNext);
+  out.put(previous);
+  out.put(next);
+  out.put(head);
+  out.put(tail);
+  out.put(heap);
+  out.put(heapPosition);
+  out.put(useCount);
+  out.put(loadTime);
+  out.put(frameNextUse);
+  out.put(clock);
+  out.put(randomState);
+  out.put(lastUse);
+  out.put(referencedBit);
+  out.put(hand);
+  out.put(freeFrames);
+  out.put(released);
+  out.put(lastFault);
+  out.put(stats);
+}
+
+bool PagerEngine::restore(SnapshotReader &in){
+  // every per frame array is sized by the constructor for this engine's policy and frames and has to come back the same size
+  size_t sizes[] = {framePage.size(), previous.size(), next.size(), heap.size(), heapPosition.size(), useCount.size(), loadTime.size(),
+                    frameNextUse.size(), lastUse.size(), referencedBit.size()};
+  in.get(usedFrames);
+  pageTable.restore(in);
+  tlb.restore(in);
+  in.get(framePage);
+  in.get(ringNext);
+  in.get(previous);
+  in.get(next);
+  in.get(head);
+  in.get(tail);
+  in.get(heap);
+  in.get(heapPosition);
+  in.get(useCount);
+  in.get(loadTime);
+  in.get(frameNextUse);
+  in.get(clock);
+  in.get(randomState);
+  in.get(lastUse);
+  in.get(referencedBit);
+  in.get(hand);
+  in.get(freeFrames);
+  in.get(released);
+  in.get(lastFault);
+  in.get(stats);
+  size_t restoredSizes[] = {framePage.size(), previous.size(), next.size(), heap.size(), heapPosition.size(), useCount.size(), loadTime.size(),
+                            frameNextUse.size(), lastUse.size(), referencedBit.size()};
+  return !in.failed && !memcmp(sizes, restoredSizes, sizeof(sizes)) && usedFrames >= 0 && usedFrames <= frames;
+}
+
+template<PagerPolicy Policy>
+bool PagerEngine::referenceAs(long long page, int &frame, long long &victim, long long nextUse){
+  bool evicting;
+  stats.references++;
+  victim = NO_PAGE;
+  {
+    ProfileScope scope(PAGE_TABLE_STAGE);
+    if(!tlb.enabled()) frame = pageTable.find(page);
+    else if(tlb.lookup(page, frame)) stats.tlbHits++;
+    else{
+      stats.tlbMisses++;
+      frame = pageTable.find(page);
+      if(frame != NO_FRAME) tlb.insert(page, frame);
+    }
+  }
+  if(frame != NO_FRAME){
+    stats.hits++;
+    touchAs<Policy>(frame, nextUse);
+    return false;
+  }
+
+  stats.faults++;
+  frame = claimAs<Policy>(evicting, nextUse);
+  if constexpr(Policy == PFF_POLICY){
+    // the pages PFF dropped from its resident set, which may include the frame it just handed out
+    for(size_t i = 0; i < released.size(); i++){
+      stats.evictions++;
+      pageTable.unmap(framePage[released[i]]);
+      if(tlb.enabled()) tlb.invalidate(framePage[released[i]]);
+    }
+    released.clear();
+  }
+  if(evicting){
+    victim = framePage[frame];
+    stats.evictions++;
+    pageTable.unmap(victim);
+    if(tlb.enabled()) tlb.invalidate(victim);
+  }
+  pageTable.map(page, frame);
+  if(tlb.enabled()) tlb.insert(page, frame);
+  framePage[frame] = page;
+  return true;
+}
+
+template<PagerPolicy Policy>
+void PagerEngine::repeatAs(long long page, int frame, long long count, long long nextUse){
+  stats.references += count;
+  stats.hits += count;
+  if(tlb.enabled()){
+    stats.tlbHits += count;
+    tlb.repeat(page, count);
+  }
+  touchAs<Policy>(frame, nextUse, count);
+}
+
+// a frame's use count and next use only grow with each hit, so sifting it up once from where it is ends where sifting it up
+// after every hit would have
+template<PagerPolicy Policy>
+void PagerEngine::touchAs(int frame, long long nextUse, long long count){
+  clock += count;
+  if constexpr(Policy == LRU_POLICY){
+    lruMoveToHead(frame);
+  }
+  else if constexpr(Policy == MFU_POLICY){
+    useCount[frame] += count;
+    heapSiftUp<Policy>(heapPosition[frame]);
+  }
+  else if constexpr(Policy == OPT_POLICY){
+    frameNextUse[frame] = nextUse;
+    heapSiftUp<Policy>(heapPosition[frame]);
+  }
+  else if constexpr(Policy == WSCLOCK_POLICY){
+    referencedBit[frame] = 1;
+    lastUse[frame] = clock;
+  }
+  else if constexpr(Policy == PFF_POLICY){
+    lruMoveToHead(frame);
+    lastUse[frame] = clock;
+  }
+}
+
+template<PagerPolicy Policy>
+int PagerEngine::claimAs(bool &evicting, long long nextUse){
+  ProfileScope scope(VICTIM_STAGE);
+  int frame;
+  bool full = usedFrames == frames;
+  clock++;
+
+  if constexpr(Policy == PFF_POLICY){
+    return pffClaimFrame(evicting);
+  }
+  if(!full){
+    frame = usedFrames++;
+  }
+  else if constexpr(Policy == FIFO_POLICY){
+    frame = ringNext;
+  }
+  else if constexpr(Policy == LRU_POLICY){
+    frame = tail;
+  }
+  else if constexpr(Policy == MFU_POLICY || Policy == OPT_POLICY){
+    frame = heap[0];
+  }
+  else if constexpr(Policy == WSCLOCK_POLICY){
+    frame = wsClockVictim();
+  }
+  else{
+    // xorshift32, reproducible no matter which thread the process is paged on
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 17;
+    randomState ^= randomState << 5;
+    frame = randomState % frames;
+  }
+  evicting = full;
+
+  if constexpr(Policy == FIFO_POLICY){
+    ringNext = (frame + 1) % frames;
+  }
+  else if constexpr(Policy == LRU_POLICY){
+    if(!full){
+      previous[frame] = next[frame] = NO_FRAME;
+      if(tail == NO_FRAME) tail = frame;
+      else{
+        next[frame] = head;
+        previous[head] = frame;
+      }
+      head = frame;
+    }
+    else lruMoveToHead(frame);
+  }
+  else if constexpr(Policy == MFU_POLICY || Policy == OPT_POLICY){
+    if constexpr(Policy == MFU_POLICY){
+      useCount[frame] = 1;
+      loadTime[frame] = clock;
+    }
+    else frameNextUse[frame] = nextUse;
+    if(!full){
+      heap[frame] = frame;
+      heapPosition[frame] = frame;
+      heapSiftUp<Policy>(frame);
+    }
+    // the top's key can only have gone down, a new next use is never later than NO_NEXT_USE
+    else heapSiftDown<Policy>(0);
+  }
+  else if constexpr(Policy == WSCLOCK_POLICY){
+    referencedBit[frame] = 1;
+    lastUse[frame] = clock;
+  }
+  return frame;
+}
+
+bool PagerEngine::reference(long long page, int &frame, long long &victim, long long nextUse){
+  switch(policy){
+    case LRU_POLICY: return referenceAs<LRU_POLICY>(page, frame, victim, nextUse);
+    case MFU_POLICY: return referenceAs<MFU_POLICY>(page, frame, victim, nextUse);
+    case RANDOM_POLICY: return referenceAs<RANDOM_POLICY>(page, frame, victim, nextUse);
+    case OPT_POLICY: return referenceAs<OPT_POLICY>(page, frame, victim, nextUse);
+    case WSCLOCK_POLICY: return referenceAs<WSCLOCK_POLICY>(page, frame, victim, nextUse);
+    case PFF_POLICY: return referenceAs<PFF_POLICY>(page, frame, victim, nextUse);
+    default: return referenceAs<FIFO_POLICY>(page, frame, victim, nextUse);
+  }
+}
+
+template<PagerPolicy Policy>
+void PagerEngine::touchFrameAs(int frame, long long nextUse){
+  touchAs<Policy>(frame, nextUse);
+}
+
+template<PagerPolicy Policy>
+int PagerEngine::claimFrameAs(bool &evicting, long long nextUse){
+  return claimAs<Policy>(evicting, nextUse);
+}
+
+// GlobalPager's kernels call these from globalPager.cpp
+#define INSTANTIATE_FRAME_ORDER(Policy) \
+  template void PagerEngine::touchFrameAs<Policy>(int frame, long long nextUse); \
+  template int PagerEngine::claimFrameAs<Policy>(bool &evicting, long long nextUse);
+INSTANTIATE_FRAME_ORDER(FIFO_POLICY)
+INSTANTIATE_FRAME_ORDER(LRU_POLICY)
+INSTANTIATE_FRAME_ORDER(MFU_POLICY)
+INSTANTIATE_FRAME_ORDER(RANDOM_POLICY)
+INSTANTIATE_FRAME_ORDER(OPT_POLICY)
+INSTANTIATE_FRAME_ORDER(WSCLOCK_POLICY)
+INSTANTIATE_FRAME_ORDER(PFF_POLICY)
+#undef INSTANTIATE_FRAME_ORDER
+
+int PagerEngine::wsClockVictim(){
+  int oldest = NO_FRAME;
+  for(int scanned = 0; scanned < frames; scanned++){
+    int frame = hand;
+    hand = (hand + 1) % frames;
+    if(referencedBit[frame]){
+      referencedBit[frame] = 0;
+      continue;
+    }
+    if(clock - lastUse[frame] > window) return frame;
+    if(oldest == NO_FRAME || lastUse[frame] < lastUse[oldest]) oldest = frame;
+  }
+  // every page is still in the working set, so the least recently used one the hand found unreferenced goes,
+  // or if every page had been referenced the one under the hand, whose bit it has just cleared
+  if(oldest == NO_FRAME){
+    oldest = hand;
+    hand = (hand + 1) % frames;
+  }
+  return oldest;
+}
+
+int PagerEngine::pffClaimFrame(bool &evicting){
+  int frame;
+  // a fault more than window references after the last one means the process has more frames than it needs, so it keeps only
+  // the pages it has used since then, they are all nearer the head of the list than the ones it hasn't
+  if(clock - lastFault > window){
+    while(tail != NO_FRAME && lastUse[tail] < lastFault){
+      frame = tail;
+      lruUnlink(frame);
+      freeFrames.push_back(frame);
+      released.push_back(frame);
+    }
+  }
+  lastFault = clock;
+
+  evicting = false;
+  if(!freeFrames.empty()){
+    frame = freeFrames.back();
+    freeFrames.pop_back();
+    lruPushHead(frame);
+  }
+  else if(usedFrames < frames){
+    frame = usedFrames++;
+    lruPushHead(frame);
+  }
+  else{
+    // already at --frames, so it replaces its least recently used page like LRU
+    frame = tail;
+    evicting = true;
+    lruMoveToHead(frame);
+  }
+  lastUse[frame] = clock;
+  return frame;
+}
+
+void PagerEngine::lruMoveToHead(int frame){
+  if(frame == head) return;
+  // unlinks the frame, it can't be the head so it always has a previous frame
+  next[previous[frame]] = next[frame];
+  if(frame == tail) tail = previous[frame];
+  else previous[next[frame]] = previous[frame];
+
+  previous[frame] = NO_FRAME;
+  next[frame] = head;
+  previous[head] = frame;
+  head = frame;
+}
+
+void PagerEngine::lruPushHead(int frame){
+  previous[frame] = NO_FRAME;
+  next[frame] = head;
+  if(head == NO_FRAME) tail = frame;
+  else previous[head] = frame;
+  head = frame;
+}
+
+void PagerEngine::lruUnlink(int frame){
+  if(previous[frame] == NO_FRAME) head = next[frame];
+  else next[previous[frame]] = next[frame];
+  if(next[frame] == NO_FRAME) tail = previous[frame];
+  else previous[next[frame]] = previous[frame];
+}
+
+template<PagerPolicy Policy>
+bool PagerEngine::heapBefore(int a, int b){
+  int frameA = heap[a], frameB = heap[b];
+  if constexpr(Policy == OPT_POLICY) return frameNextUse[frameA] > frameNextUse[frameB];
+  if(useCount[frameA] != useCount[frameB]) return useCount[frameA] > useCount[frameB];
+  return loadTime[frameA] < loadTime[frameB];
+}
+
+void PagerEngine::heapSwap(int a, int b){
+  int frame = heap[a];
+  heap[a] = heap[b];
+  heap[b] = frame;
+  heapPosition[heap[a]] = a;
+  heapPosition[heap[b]] = b;
+}
+
+template<PagerPolicy Policy>
+void PagerEngine::heapSiftUp(int position){
+  while(position > 0 && heapBefore<Policy>(position, (position - 1) / 2)){
+    heapSwap(position, (position - 1) / 2);
+    position = (position - 1) / 2;
+  }
+}
+
+template<PagerPolicy Policy>
+void PagerEngine::heapSiftDown(int position){
+  while(true){
+    int child = 2 * position + 1, best = position;
+    if(child < usedFrames && heapBefore<Policy>(child, best)) best = child;
+    if(child + 1 < usedFrames && heapBefore<Policy>(child + 1, best)) best = child + 1;
+    if(best == position) return;
+    heapSwap(position, best);
+    position = best;
+  }
+}
+
+void printPagerSummary(const PagerStats &stats, int pid, EventLog &log){
+  log << PID_FORM << pid << ": " << stats.faults << " page faults in " << stats.references << " references\n";
+  if(stats.tlbHits + stats.tlbMisses){
+    log << "\tTLB: " << stats.tlbHits << " hits, " << stats.tlbMisses << " misses, "
+        << (int)(100 * stats.tlbHits / (stats.tlbHits + stats.tlbMisses)) << "% hit rate\n";
+  }
+  if(log.logs(PROCESS_LOG)) log << '\t' << stats.hits << " hits, " << stats.evictions << " evictions\n";
+}
+
+void nextUses(PageTable &seen, const vector<long long> &pages, vector<long long> &upcoming){
+  // a process's burst is an int, so every index fits where a page table keeps its frame
+  seen.clear();
+  upcoming.resize(pages.size());
+  for(long long t = (long long)pages.size() - 1; t >= 0; t--){
+    int later = seen.find(pages[t]);
+    upcoming[t] = later == NO_FRAME ? NO_NEXT_USE : later;
+    seen.map(pages[t], t);
+  }
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+__attribute__((target("avx2")))
+static void translatePagesAvx2(const int64_t *addresses, long long count, int pageShift, long long *pages){
+  __m128i shift = _mm_cvtsi32_si128(pageShift);
+  long long t = 0;
+  for(; t + 4 <= count; t += 4){
+    __m256i block = _mm256_loadu_si256((const __m256i *)(addresses + t));
+    _mm256_storeu_si256((__m256i *)(pages + t), _mm256_srl_epi64(block, shift));
+  }
+  for(; t < count; t++) pages[t] = addresses[t] >> pageShift;
+}
+
+// checked once at startup, which can be before the compiler's own CPU detection has run, so it is run here first
+static bool cpuHasAvx2(){
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx2");
+}
+
+static const bool hasAvx2 = cpuHasAvx2();
+#endif
+
+void translatePages(const int64_t *addresses, long long count, int pageShift, long long *pages){
+#if defined(__x86_64__) || defined(__i386__)
+  if(hasAvx2){
+    translatePagesAvx2(addresses, count, pageShift, pages);
+    return;
+  }
+#endif
+  for(long long t = 0; t < count; t++) pages[t] = addresses[t] >> pageShift;
+}
+
+// pages one address, which is only logged in the Logged kernels and only then if it is sampled
+template<PagerPolicy Policy, bool Logged>
+static inline void pageAddressAs(PagerEngine &engine, int pid, long long address, long long nextUse, int pageShift, EventLog &log){
+  long long page = address >> pageShift, victim;
+  int frame;
+  bool fault = engine.referenceAs<Policy>(page, frame, victim, nextUse);
+  if constexpr(Logged){
+    if(log.sampled(engine.stats.references)){
+      log << '\t' << PID_FORM << pid << " address " << address << " (page " << page << "): ";
+      if(!fault) log << "hit in frame " << frame << '\n';
+      else if(victim == NO_PAGE) log << "page fault, loaded into free frame " << frame << '\n';
+      else log << "page fault, replaced page " << victim << " in frame " << frame << '\n';
+    }
+  }
+}
+
+// a logged kernel pages one address at a time so that each one can be logged, the others translate a block of addresses at once
+// and page every run of consecutive references to the page just referenced in one go, a run can go on into the next block
+template<PagerPolicy Policy, bool Logged>
+static void pageSliceAs(PagerEngine &engine, int pid, const int64_t *addresses, long long count, const long long *nextUse, int pageShift, EventLog &log){
+  ProfileScope scope(PAGE_STAGE);
+  if constexpr(Logged){
+    for(long long t = 0; t < count; t++){
+      pageAddressAs<Policy, Logged>(engine, pid, addresses[t], Policy == OPT_POLICY ? nextUse[t] : NO_NEXT_USE, pageShift, log);
+    }
+    return;
+  }
+  long long pages[TRANSLATE_BLOCK], lastPage = NO_PAGE, victim;
+  int frame = NO_FRAME;
+  for(long long first = 0; first < count; first += TRANSLATE_BLOCK){
+    long long length = count - first < TRANSLATE_BLOCK ? count - first : TRANSLATE_BLOCK;
+    translatePages(addresses + first, length, pageShift, pages);
+    for(long long t = 0; t < length;){
+      if(pages[t] != lastPage){
+        lastPage = pages[t];
+        engine.referenceAs<Policy>(lastPage, frame, victim, Policy == OPT_POLICY ? nextUse[first + t] : NO_NEXT_USE);
+        t++;
+        continue;
+      }
+      long long run = 1;
+      while(t + run < length && pages[t + run] == lastPage) run++;
+      engine.repeatAs<Policy>(lastPage, frame, run, Policy == OPT_POLICY ? nextUse[first + t + run - 1] : NO_NEXT_USE);
+      t += run;
+    }
+  }
+}
+
+// pages already translated page numbers the way the unlogged pageSliceAs does, merging each run of references to one page
+template<PagerPolicy Policy>
+static void pagePagesAs(PagerEngine &engine, const long long *pages, long long count, const long long *nextUse){
+  long long victim;
+  int frame;
+  for(long long t = 0; t < count;){
+    engine.referenceAs<Policy>(pages[t], frame, victim, Policy == OPT_POLICY ? nextUse[t] : NO_NEXT_USE);
+    long long run = 1;
+    while(t + run < count && pages[t + run] == pages[t]) run++;
+    if(run > 1) engine.repeatAs<Policy>(pages[t], frame, run - 1, Policy == OPT_POLICY ? nextUse[t + run - 1] : NO_NEXT_USE);
+    t += run;
+  }
+}
+
+// every instantiation, indexed [policy][logged] in the order of PagerPolicy, pagePages is never logged so both share it
+static const PagerKernels kernelTable[][2] = {
+  {{pageSliceAs<FIFO_POLICY, false>, pagePagesAs<FIFO_POLICY>}, {pageSliceAs<FIFO_POLICY, true>, pagePagesAs<FIFO_POLICY>}},
+  {{pageSliceAs<LRU_POLICY, false>, pagePagesAs<LRU_POLICY>}, {pageSliceAs<LRU_POLICY, true>, pagePagesAs<LRU_POLICY>}},
+  {{pageSliceAs<MFU_POLICY, false>, pagePagesAs<MFU_POLICY>}, {pageSliceAs<MFU_POLICY, true>, pagePagesAs<MFU_POLICY>}},
+  {{pageSliceAs<RANDOM_POLICY, false>, pagePagesAs<RANDOM_POLICY>}, {pageSliceAs<RANDOM_POLICY, true>, pagePagesAs<RANDOM_POLICY>}},
+  {{pageSliceAs<OPT_POLICY, false>, pagePagesAs<OPT_POLICY>}, {pageSliceAs<OPT_POLICY, true>, pagePagesAs<OPT_POLICY>}},
+  {{pageSliceAs<WSCLOCK_POLICY, false>, pagePagesAs<WSCLOCK_POLICY>}, {pageSliceAs<WSCLOCK_POLICY, true>, pagePagesAs<WSCLOCK_POLICY>}},
+  {{pageSliceAs<PFF_POLICY, false>, pagePagesAs<PFF_POLICY>}, {pageSliceAs<PFF_POLICY, true>, pagePagesAs<PFF_POLICY>}}
+};
+
+const PagerKernels &pagerKernels(PagerPolicy policy, bool logged){
+  return kernelTable[policy][logged];
+}
+
+PagerStats pageProcess(PagerEngine &engine, int pid, const int64_t *addresses, long long count, int pageShift, EventLog &log){
+  vector<long long> upcoming;
+  engine.reset();
+  if(engine.looksAhead()){
+    vector<long long> pages(count);
+    for(long long t = 0; t < count; t++) pages[t] = addresses[t] >> pageShift;
+    engine.nextUses(pages, upcoming);
+  }
+  pagerKernels(engine.pagerPolicy(), log.logs(REFERENCE_LOG)).pageSlice(engine, pid, addresses, count, upcoming.data(), pageShift, log);
+  printPagerSummary(engine.stats, pid, log);
+  return engine.stats;
+}
@@ -0,0 +1,192 @@
+// FILE: pagerEngine.h
+// A Bautista, B Franco, E Mora
+// OS, Fall 2023, Transy U
+//
+//	interface for babyOS's page replacement engine
+//	Every policy keeps its page to frame map in a PageTable (pageTable.h) that only grows with the pages a process touches,
+//	optionally fronted by a Tlb, and its replacement order in flat arrays over the frames allocated once when the engine is made,
+//	so a reference only allocates when it touches a new part of the page table and costs
+//		FIFO	O(1), a ring over the frames since a FIFO victim's frame always takes the next page in
+//		LRU		O(1), a doubly linked list threaded through the frames, most recently used at the head
+//		MFU		O(log frames), a heap of the frames keyed on use count, ties going to the page loaded first
+//		Random	O(1), a victim drawn from the engine's own seeded generator so runs are repeatable
+//		OPT		O(log frames), Belady's optimal policy, a heap of the frames keyed on when each page is next used, which the caller
+//				passes with every reference from a next-use index that nextUses builds in one backward pass before the process is paged
+//		WSClock	O(frames) per fault at worst, a clock hand that takes the first page neither referenced since the hand last passed
+//				it nor used within the last --window references, the oldest page it passed if every page is in the working set
+//		PFF		O(1) amortized, LRU within a resident set that grows by a frame on each fault while faults come within --window
+//				references of each other and, when they don't, shrinks to the pages used since the last fault, so the frames a
+//				process holds change as it runs and --frames is only its limit. Pages released that way count as evictions
+//	The per-address loops are templates on the policy and on whether references are logged, pagerKernels hands out the
+//	instantiation a run needs, so the policy is branched on once per run rather than once per address
+//	The unlogged loops translate addresses to pages a block of TRANSLATE_BLOCK at a time (translatePages) and page a run of
+//	consecutive references to one page with one call to repeatAs, since such a page can only hit in the frame it was left in.
+//	Only runs of the same page are merged, a run of hits across several resident pages is still paged one reference at a time
+//	reference switches to the same instantiations for callers that page one reference at a time
+//
+
+#ifndef PAGER_ENGINE_H
+#define PAGER_ENGINE_H
+
+#include "babyOS.h"
+#include "eventLog.h"
+#include "pageTable.h"
+#include <stdint.h>
+#include <vector>
+
+using namespace std;
+
+#define RANDOM_SEED 2023
+// the next use of a page that is never referenced again
+#define NO_NEXT_USE LLONG_MAX
+// number of addresses the unlogged kernels translate to pages at a time
+#define TRANSLATE_BLOCK 256
+
+enum PagerPolicy{
+  FIFO_POLICY,
+  LRU_POLICY,
+  MFU_POLICY,
+  RANDOM_POLICY,
+  OPT_POLICY,
+  WSCLOCK_POLICY,
+  PFF_POLICY
+};
+
+// tlbHits and tlbMisses stay 0 without a TLB, and steals, the frames taken from other processes, without --global-frames
+struct PagerStats{
+  long long references, faults, hits, evictions, tlbHits, tlbMisses, steals;
+};
+
+// returns the policy named by pagerType, which commandErrorCheck has already made sure is valid
+PagerPolicy policyFromName(string_view pagerType);
+
+// returns the --pagerType name of policy
+const char *policyName(PagerPolicy policy);
+
+// sets pages[t] to addresses[t] >> pageShift for each of the count addresses, four at a time with AVX2 on a CPU that has it
+// addresses are never negative, so the logical shift AVX2 has gives the same pages as the arithmetic one
+void translatePages(const int64_t *addresses, long long count, int pageShift, long long *pages);
+
+// sets upcoming[t] to the index of the next reference to pages[t] after t, NO_NEXT_USE if there isn't one
+// seen is cleared and used to remember the last time each page was seen on the way back, so it must cover every page in pages
+void nextUses(PageTable &seen, const vector<long long> &pages, vector<long long> &upcoming);
+
+class PagerEngine{
+ public:
+  // pages is the size of the address space in pages, window the working set window of WSClock and PFF in references,
+  // tlbEntries of 0 pages without a TLB
+  PagerEngine(PagerPolicy policy, int frames, long long pages, int window, int tlbEntries = 0, int tlbWays = 0);
+
+  // empties every frame, flushes the TLB, and zeroes stats so the engine can page the next process
+  void reset();
+
+  // writes the frames, page table, TLB, replacement order, and stats to out, restore reads them back into an engine made
+  // with the same policy, frames, pages, window, and TLB, in place of whatever it was paging
+  // restore returns false if in ran out or its frames don't fit this engine's
+  void save(SnapshotWriter &out);
+  bool restore(SnapshotReader &in);
+
+  PagerPolicy pagerPolicy(){
+    return policy;
+  }
+
+  // true if every reference has to be given the time its page is next used, which only OPT needs
+  bool looksAhead(){
+    return policy == OPT_POLICY;
+  }
+
+  // nextUses on a page table the engine keeps for it, only an OPT engine's covers the whole address space
+  void nextUses(const vector<long long> &pages, vector<long long> &upcoming){
+    ::nextUses(ahead, pages, upcoming);
+  }
+
+  // references page, returns true if it faulted
+  // frame is set to the frame the page is in afterwards and victim to the page that was evicted for it or NO_PAGE
+  // nextUse is the time the page is referenced again, any increasing count of references will do, NO_NEXT_USE if it never is
+  bool reference(long long page, int &frame, long long &victim, long long nextUse = NO_NEXT_USE);
+
+  // reference compiled for one policy, which has to be the engine's, so that the policy's branches are resolved at compile time
+  // it is only instantiated in pagerEngine.cpp, everywhere else goes through reference or the kernels of pagerKernels
+  template<PagerPolicy Policy>
+  bool referenceAs(long long page, int &frame, long long &victim, long long nextUse);
+
+  // references page count more times right after a reference to it left it in frame, which are all hits, leaving the engine
+  // exactly as count calls to referenceAs would without looking page up again, nextUse is the next use after the last of them
+  template<PagerPolicy Policy>
+  void repeatAs(long long page, int frame, long long count, long long nextUse);
+
+  // the replacement order on its own, for a pager such as GlobalPager that keeps its own map of which page is in which frame
+  // touchFrameAs records a hit on frame, claimFrameAs picks the frame to load a faulting page into and sets evicting if it is
+  // taken from a page rather than free, PFF can't be driven this way since it frees frames of its own accord
+  // like referenceAs they are compiled for the engine's policy, pagerEngine.cpp instantiates them for every policy
+  template<PagerPolicy Policy> void touchFrameAs(int frame, long long nextUse);
+  template<PagerPolicy Policy> int claimFrameAs(bool &evicting, long long nextUse);
+
+  PagerStats stats;
+
+ private:
+  void lruMoveToHead(int frame);
+  void lruPushHead(int frame);
+  void lruUnlink(int frame);
+  int wsClockVictim();
+  int pffClaimFrame(bool &evicting);
+  // records count hits in a row on frame
+  template<PagerPolicy Policy> void touchAs(int frame, long long nextUse, long long count = 1);
+  template<PagerPolicy Policy> int claimAs(bool &evicting, long long nextUse);
+  template<PagerPolicy Policy> void heapSiftUp(int position);
+  template<PagerPolicy Policy> void heapSiftDown(int position);
+  // true if the frame at position a should be evicted before the one at position b
+  template<PagerPolicy Policy> bool heapBefore(int a, int b);
+  void heapSwap(int a, int b);
+
+  PagerPolicy policy;
+  int frames, usedFrames, window;
+  PageTable pageTable, ahead;
+  Tlb tlb;
+  vector<long long> framePage;
+  // FIFO
+  int ringNext;
+  // LRU and PFF
+  vector<int> previous, next;
+  int head, tail;
+  // MFU and OPT
+  vector<int> heap, heapPosition;
+  vector<long long> useCount, loadTime, frameNextUse;
+  long long clock;
+  // Random
+  uint32_t randomState;
+  // WSClock and PFF, lastUse is the clock of each frame's last reference
+  vector<long long> lastUse;
+  vector<char> referencedBit;
+  int hand;
+  // PFF, freeFrames are frames the resident set has shrunk out of and released the ones freed by the last claimFrame
+  // whose pages reference still has to unmap
+  vector<int> freeFrames, released;
+  long long lastFault;
+};
+
+// a policy's paging loops with its replacement compiled in, from pagerKernels
+// pageSlice pages the count addresses starting at addresses with process pid's engine
+// nextUse holds each address's next use for OPT and is not read for any other policy, pageShift is log2 of the page size
+// the logged kernels log every sampled reference, the others never look at log so a run below REFERENCE_LOG doesn't test for it per address
+// pagePages pages count page numbers that are already translated, unlogged, for a caller such as PagerSweep that replays them more than once
+typedef void (*SliceKernel)(PagerEngine &engine, int pid, const int64_t *addresses, long long count, const long long *nextUse, int pageShift, EventLog &log);
+typedef void (*PagesKernel)(PagerEngine &engine, const long long *pages, long long count, const long long *nextUse);
+struct PagerKernels{
+  SliceKernel pageSlice;
+  PagesKernel pagePages;
+};
+
+// returns the kernels compiled for policy, logged picks the ones that log at REFERENCE_LOG
+// the table behind it is built once at startup, so a run picks its kernels once and every address after that is paged without a policy branch
+const PagerKernels &pagerKernels(PagerPolicy policy, bool logged);
+
+// logs the page faults in process pid's stats and its TLB hit rate if it had a TLB, and its hits and evictions at PROCESS_LOG
+void printPagerSummary(const PagerStats &stats, int pid, EventLog &log);
+
+// pages the count addresses starting at addresses with engine, which is reset first, logging each reference and a summary for the process
+// for OPT the addresses are indexed with nextUses first
+// pageShift is log2 of the page size, which inputErrorCheck guarantees is a power of two
+PagerStats pageProcess(PagerEngine &engine, int pid, const int64_t *addresses, long long count, int pageShift, EventLog &log);
+
+#endif // PAGER_ENGINE_H
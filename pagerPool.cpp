@@ -0,0 +1,161 @@
+// FILE: pagerPool.cpp
+// A Bautista, B Franco, E Mora
+// OS, Fall 2023, Transy U
+//
+//	implementation of the --threads worker pool
+//
+//	Each worker has its own PagerEngine and EventLog and pages into the output of the job it is working on. The loader still prints its
+//	errors straight to cout from the submitting thread, so while the pool is running cout's buffer is swapped for a
+//	ThreadOutputBuffer that keeps that output in a job of its own between the processes it was printed between.
+//	Only the submitting thread ever prints a finished job, always from the front of jobs, so output comes out in the order
+//	the processes appeared in the input file
+//	No more than POOL_WINDOW processes per worker are held at once so the loader still runs in bounded memory
+//
+
+#include "pagerPool.h"
+#include <iostream>
+#include <sstream>
+
+using namespace std;
+
+thread_local string *ThreadOutputBuffer::target = NULL;
+
+ThreadOutputBuffer::ThreadOutputBuffer(streambuf *original){
+  this->original = original;
+}
+
+void ThreadOutputBuffer::capture(string *output){
+  target = output;
+}
+
+int ThreadOutputBuffer::overflow(int c){
+  if(c == traits_type::eof()) return traits_type::not_eof(c);
+  if(target){
+    target->push_back((char)c);
+    return c;
+  }
+  return original->sputc((char)c);
+}
+
+streamsize ThreadOutputBuffer::xsputn(const char *s, streamsize n){
+  if(target){
+    target->append(s, n);
+    return n;
+  }
+  return original->sputn(s, n);
+}
+
+int ThreadOutputBuffer::sync(){
+  return target ? 0 : original->pubsync();
+}
+
+PagerPool::PagerPool(int threads, int frames, long long pages, int workingSetWindow, int tlbEntries, int tlbWays, int pageShift, LogLevel level, int sample, const char *pagerType, ostream &out, vector<PagerStats> &stats)
+  : original(cout.rdbuf()), pagedOutput(out.rdbuf()), outputBuffer(cout.rdbuf()), stats(stats){
+  this->frames = frames;
+  this->pages = pages;
+  this->workingSetWindow = workingSetWindow;
+  this->tlbEntries = tlbEntries;
+  this->tlbWays = tlbWays;
+  this->pageShift = pageShift;
+  this->level = level;
+  this->sample = sample;
+  policy = policyFromName(pagerType);
+  stopping = false;
+  // a window counts the submitting thread's output between processes as well, hence the doubling
+  window = 2 * POOL_WINDOW * threads;
+
+  jobs.emplace_back();
+  mainJob = &jobs.back();
+  mainJob->done = false;
+  mainJob->paged = false;
+  out.flush();
+  cout.flush();
+  cout.rdbuf(&outputBuffer);
+  ThreadOutputBuffer::capture(&mainJob->output);
+
+  for(int i = 0; i < threads; i++) workers.emplace_back(&PagerPool::work, this);
+}
+
+PagerPool::~PagerPool(){
+  finish();
+}
+
+void PagerPool::submit(const PCB &block){
+  unique_lock<mutex> lock(poolMutex);
+  jobDone.wait(lock, [this]{
+    printFinished();
+    return jobs.size() < window;
+  });
+
+  mainJob->done = true;
+  jobs.emplace_back();
+  PagerJob *job = &jobs.back();
+  job->pid = block.pid;
+  job->addresses.assign(block.addresses, block.addresses + block.burst);
+  job->done = false;
+  job->paged = true;
+  pending.push(job);
+
+  jobs.emplace_back();
+  mainJob = &jobs.back();
+  mainJob->done = false;
+  mainJob->paged = false;
+  ThreadOutputBuffer::capture(&mainJob->output);
+  lock.unlock();
+  jobReady.notify_one();
+}
+
+void PagerPool::finish(){
+  if(workers.empty()) return;
+  unique_lock<mutex> lock(poolMutex);
+  ThreadOutputBuffer::capture(NULL);
+  mainJob->done = true;
+  jobDone.wait(lock, [this]{
+    printFinished();
+    return jobs.empty();
+  });
+  stopping = true;
+  lock.unlock();
+  jobReady.notify_all();
+  for(size_t i = 0; i < workers.size(); i++) workers[i].join();
+  workers.clear();
+
+  cout.rdbuf(original);
+  cout.flush();
+  if(pagedOutput) pagedOutput->pubsync();
+}
+
+void PagerPool::work(){
+  PagerEngine engine(policy, frames, pages, workingSetWindow, tlbEntries, tlbWays);
+  ostringstream output;
+  EventLog log(level, sample, output);
+  while(true){
+    unique_lock<mutex> lock(poolMutex);
+    jobReady.wait(lock, [this]{ return stopping || !pending.empty(); });
+    if(pending.empty()) return;
+    PagerJob *job = pending.front();
+    pending.pop();
+    lock.unlock();
+
+    output.str("");
+    job->stats = pageProcess(engine, job->pid, job->addresses.data(), job->addresses.size(), pageShift, log);
+    log.flush();
+    job->output = output.str();
+
+    lock.lock();
+    job->done = true;
+    lock.unlock();
+    jobDone.notify_one();
+  }
+}
+
+void PagerPool::printFinished(){
+  while(!jobs.empty() && jobs.front().done){
+    PagerJob &job = jobs.front();
+    // out may have no buffer at all when --report throws the paging output away
+    streambuf *destination = job.paged ? pagedOutput : original;
+    if(destination) destination->sputn(job.output.data(), job.output.size());
+    if(job.paged) stats.push_back(job.stats);
+    jobs.pop_front();
+  }
+}
@@ -0,0 +1,97 @@
+// FILE: pagerPool.h
+// A Bautista, B Franco, E Mora
+// OS, Fall 2023, Transy U
+//
+//	interface for the worker pool that pages processes in parallel for --threads
+//	Every process is paged independently from a reset PagerEngine so the simulations can run on any worker,
+//	only their output has to be put back in the order the processes were submitted, which keeps a parallel
+//	run byte for byte identical to a serial one
+//
+
+#ifndef PAGER_POOL_H
+#define PAGER_POOL_H
+
+#include "babyOS.h"
+#include "pagerEngine.h"
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <queue>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+// number of processes that may be submitted but not yet printed per worker before submit waits
+#define POOL_WINDOW 4
+
+// holds one submitted process and the output its simulation printed until it is that process's turn to be printed
+// paged is false for the jobs that hold the submitting thread's output
+// the loader reuses its buffer for the next process's addresses, so a job keeps its own copy of the ones it pages
+struct PagerJob{
+  int pid;
+  vector<int64_t> addresses;
+  string output;
+  PagerStats stats;
+  bool done, paged;
+};
+
+// stands in for cout's buffer while the pool is running so that a thread's output lands in the job it has been told to capture into
+// output from a thread that isn't capturing is passed through to the original buffer
+class ThreadOutputBuffer : public streambuf{
+ public:
+  ThreadOutputBuffer(streambuf *original);
+
+  // the string output is captured into by the calling thread, NULL to pass output through
+  static void capture(string *output);
+
+ protected:
+  int overflow(int c);
+  streamsize xsputn(const char *s, streamsize n);
+  int sync();
+
+ private:
+  static thread_local string *target;
+  streambuf *original;
+};
+
+class PagerPool{
+ public:
+  // the processes' paging output is printed to out, each process's paging stats are appended to stats in submission order
+  PagerPool(int threads, int frames, long long pages, int workingSetWindow, int tlbEntries, int tlbWays, int pageShift, LogLevel level, int sample, const char *pagerType, ostream &out, vector<PagerStats> &stats);
+  ~PagerPool();
+
+  // hands block to a worker, waiting if POOL_WINDOW processes per worker are already outstanding
+  void submit(const PCB &block);
+
+  // waits for every submitted process to be paged and prints whatever is left in order
+  void finish();
+
+ private:
+  void work();
+  // prints the finished jobs at the front of jobs, stops at the first unfinished one
+  // lock must be held on poolMutex
+  void printFinished();
+
+  int frames, workingSetWindow, tlbEntries, tlbWays, pageShift, sample;
+  long long pages;
+  PagerPolicy policy;
+  LogLevel level;
+  bool stopping;
+  size_t window;
+  // jobs are kept in submission order, pending holds the jobs that haven't been picked up by a worker yet
+  // output printed by the submitting thread between submissions is kept as a finished job of its own so it stays in order
+  deque<PagerJob> jobs;
+  queue<PagerJob *> pending;
+  PagerJob *mainJob;
+  vector<thread> workers;
+  mutex poolMutex;
+  condition_variable jobReady, jobDone;
+  streambuf *original, *pagedOutput;
+  ThreadOutputBuffer outputBuffer;
+  vector<PagerStats> &stats;
+};
+
+#endif // PAGER_POOL_H
@@ -0,0 +1,119 @@
+// FILE: pagerSweep.cpp
+// A Bautista, B Franco, E Mora
+// OS, Fall 2023, Transy U
+//
+//	implementation of --sweep
+//
+//	The stack distance of the reference at time t to a page last used at time s is one more than the number of distinct
+//	pages referenced between s and t. marks has a 1 at the last use of every page, so that count is a range sum over
+//	marks and the whole pass is O(n log n) in the number of references no matter how many frame counts are swept
+//	The pages are renumbered densely first so lastUse is sized by the pages a process touches rather than by --pages
+//	Every other policy is replayed through a PagerEngine for each frame count, the engines are made once and reset, and each
+//	replay goes through the policy's pagePages kernel so the policy is branched on once per replay rather than once per reference
+//
+
+#include "pagerSweep.h"
+#include "profiler.h"
+#include <algorithm>
+#include <iomanip>
+
+using namespace std;
+
+PagerSweep::PagerSweep(const vector<PagerPolicy> &policies, const vector<int> &frameCounts, long long pages, int window)
+  : policies(policies), frameCounts(frameCounts){
+  maxFrames = 0;
+  for(size_t j = 0; j < frameCounts.size(); j++){
+    if(frameCounts[j] > maxFrames) maxFrames = frameCounts[j];
+  }
+  distances.resize(maxFrames + 2);
+  faults.assign(policies.size(), vector<long long>(frameCounts.size(), 0));
+  engines.assign(policies.size(), vector<PagerEngine *>(frameCounts.size(), (PagerEngine *)NULL));
+  for(size_t i = 0; i < policies.size(); i++){
+    if(policies[i] == LRU_POLICY) continue;
+    for(size_t j = 0; j < frameCounts.size(); j++) engines[i][j] = new PagerEngine(policies[i], frameCounts[j], pages, window);
+  }
+}
+
+PagerSweep::~PagerSweep(){
+  for(size_t i = 0; i < engines.size(); i++){
+    for(size_t j = 0; j < engines[i].size(); j++) delete engines[i][j];
+  }
+}
+
+void PagerSweep::pageProcess(const int64_t *addresses, long long count, int pageShift){
+  ProfileScope scope(PAGE_STAGE);
+  referenced.resize(count);
+  for(long long t = 0; t < count; t++) referenced[t] = addresses[t] >> pageShift;
+  upcoming.clear();
+  for(size_t i = 0; i < policies.size(); i++){
+    if(policies[i] == OPT_POLICY) engines[i][0]->nextUses(referenced, upcoming);
+  }
+
+  for(size_t i = 0; i < policies.size(); i++){
+    if(policies[i] == LRU_POLICY){
+      stackDistances(i);
+      continue;
+    }
+    PagesKernel pagePages = pagerKernels(policies[i], false).pagePages;
+    for(size_t j = 0; j < frameCounts.size(); j++){
+      PagerEngine *engine = engines[i][j];
+      engine->reset();
+      pagePages(*engine, referenced.data(), count, upcoming.data());
+      faults[i][j] += engine->stats.faults;
+    }
+  }
+}
+
+void PagerSweep::stackDistances(int row){
+  int references = referenced.size();
+  // distances[maxFrames + 1] collects first references and anything further down the stack than the most frames swept
+  long long beyond;
+  for(size_t d = 0; d < distances.size(); d++) distances[d] = 0;
+  marks.assign(references + 1, 0);
+
+  distinctPages = referenced;
+  sort(distinctPages.begin(), distinctPages.end());
+  distinctPages.erase(unique(distinctPages.begin(), distinctPages.end()), distinctPages.end());
+  denseReferenced.resize(references);
+  for(int t = 0; t < references; t++){
+    denseReferenced[t] = lower_bound(distinctPages.begin(), distinctPages.end(), referenced[t]) - distinctPages.begin();
+  }
+  lastUse.assign(distinctPages.size(), 0);
+
+  for(int t = 1; t <= references; t++){
+    int page = denseReferenced[t - 1];
+    int last = lastUse[page];
+    if(!last){
+      distances[maxFrames + 1]++;
+    }
+    else{
+      // counts the marks in (last, t), the pages used since this one was
+      int distance = 1;
+      for(int i = t - 1; i > 0; i -= i & -i) distance += marks[i];
+      for(int i = last; i > 0; i -= i & -i) distance -= marks[i];
+      distances[distance > maxFrames ? maxFrames + 1 : distance]++;
+      for(int i = last; i <= references; i += i & -i) marks[i]--;
+    }
+    for(int i = t; i <= references; i += i & -i) marks[i]++;
+    lastUse[page] = t;
+  }
+
+  // a reference faults with F frames if its distance is greater than F
+  for(size_t j = 0; j < frameCounts.size(); j++){
+    beyond = distances[maxFrames + 1];
+    for(int d = frameCounts[j] + 1; d <= maxFrames; d++) beyond += distances[d];
+    faults[row][j] += beyond;
+  }
+}
+
+void PagerSweep::print(ostream &out){
+  out << "\nPage faults by pager type (rows) and frames (columns):\n";
+  out << setw(8) << "";
+  for(size_t j = 0; j < frameCounts.size(); j++) out << setw(12) << frameCounts[j];
+  out << "\n";
+  for(size_t i = 0; i < policies.size(); i++){
+    out << setw(8) << left << policyName(policies[i]) << right;
+    for(size_t j = 0; j < frameCounts.size(); j++) out << setw(12) << faults[i][j];
+    out << "\n";
+  }
+}
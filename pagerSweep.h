@@ -0,0 +1,55 @@
+// FILE: pagerSweep.h
+// A Bautista, B Franco, E Mora
+// OS, Fall 2023, Transy U
+//
+//	interface for --sweep, which pages every process once for each combination of the pager types and frame counts
+//	listed with --pagerType and --frames and totals the page faults into a matrix
+//	LRU is never actually replayed, instead one pass over each process works out the stack distance of every reference
+//	(Mattson et al.), since LRU has the inclusion property a reference faults with F frames exactly when its distance is
+//	greater than F, so that single pass gives LRU's page faults for every frame count at once
+//
+
+#ifndef PAGER_SWEEP_H
+#define PAGER_SWEEP_H
+
+#include "babyOS.h"
+#include "pagerEngine.h"
+#include <ostream>
+#include <vector>
+
+using namespace std;
+
+class PagerSweep{
+ public:
+  // window is the working set window of WSClock and PFF
+  PagerSweep(const vector<PagerPolicy> &policies, const vector<int> &frameCounts, long long pages, int window);
+  ~PagerSweep();
+
+  // adds the page faults the count addresses starting at addresses cause under every combination to the matrix, pageShift is log2 of the page size
+  void pageProcess(const int64_t *addresses, long long count, int pageShift);
+
+  // prints the page fault matrix with a row for each pager type and a column for each frame count
+  void print(ostream &out);
+
+ private:
+  // adds LRU's page faults for every frame count to faults[row] from the stack distance of each reference in referenced
+  void stackDistances(int row);
+
+  vector<PagerPolicy> policies;
+  vector<int> frameCounts;
+  int maxFrames;
+  // faults[policy][frame count], totalled over every process
+  vector<vector<long long>> faults;
+  // engines[policy][frame count], NULL for LRU which is covered by stackDistances
+  vector<vector<PagerEngine *>> engines;
+  // the page numbers of the process currently being swept, and those page numbers renumbered 0, 1, 2, ... by stackDistances
+  // upcoming is their next-use index if OPT is swept
+  vector<long long> referenced, distinctPages, upcoming;
+  vector<int> denseReferenced;
+  // lastUse[dense page] is the 1-based time the page was last referenced, 0 if it hasn't been
+  // marks is a Fenwick tree over time with a 1 at every page's last use, distances[d] counts references at stack distance d
+  vector<int> lastUse, marks;
+  vector<long long> distances;
+};
+
+#endif // PAGER_SWEEP_H
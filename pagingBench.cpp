@@ -0,0 +1,104 @@
+// FILE: pagingBench.cpp
+// A Bautista, B Franco, E Mora
+// OS, Fall 2023, Transy U
+//
+//	microbenchmark comparing paging one address at a time through PagerEngine::reference, the way every reference used to be
+//	paged, against the unlogged kernels of pagerKernels, which translate a block of addresses at once and page each run of
+//	references to the page just referenced in one go
+//
+//	To use pagingBench enter the number of references to page, otherwise BENCH_REFERENCES is used
+//	ex. ./pagingBench 10000000
+//	The references walk a working set of BENCH_WORKING_SET pages BENCH_STRIDE bytes at a time and jump to a random page
+//	once every BENCH_JUMP references on average, the looping pattern the kernels' fast path is for, and are paged into
+//	BENCH_FRAMES frames of DEFAULT_SIZE bytes under every pager type. Both paths have to end with the same stats
+//	translatePages is timed on its own against shifting each address
+//
+
+#include "babyOS.h"
+#include "eventLog.h"
+#include "pagerEngine.h"
+#include <iostream>
+#include <cstring>
+#include <stdlib.h>
+#include <chrono>
+#include <vector>
+
+using namespace std;
+
+#define BENCH_REFERENCES 10000000
+#define BENCH_SEED 3
+#define BENCH_PAGES 256
+#define BENCH_FRAMES 16
+#define BENCH_WORKING_SET 24
+#define BENCH_STRIDE 16
+#define BENCH_JUMP 64
+#define BENCH_WINDOW 16
+
+int main(int argc, char **argv){
+  long long count = BENCH_REFERENCES;
+  int pageSize = atoi(DEFAULT_SIZE), pageShift = 0;
+  if(argc > 1) count = atoll(argv[1]);
+  if(count <= 0){
+    cout << "\tERROR: Number of references must be a positive integer\n";
+    exit(1);
+  }
+  while((1 << pageShift) < pageSize) pageShift++;
+
+  vector<int64_t> addresses(count);
+  long long base = 0, offset = 0;
+  srand(BENCH_SEED);
+  for(long long t = 0; t < count; t++){
+    if(rand() % BENCH_JUMP == 0) base = rand() % (BENCH_PAGES - BENCH_WORKING_SET) * (long long)pageSize;
+    addresses[t] = base + offset;
+    offset = (offset + BENCH_STRIDE) % (BENCH_WORKING_SET * pageSize);
+  }
+
+  // the translation on its own, the sums keep either loop from being optimized away and must match
+  vector<long long> pages(count), translated(count);
+  chrono::steady_clock::time_point start = chrono::steady_clock::now();
+  for(long long t = 0; t < count; t++) pages[t] = addresses[t] >> pageShift;
+  chrono::duration<double> shiftTime = chrono::steady_clock::now() - start;
+  start = chrono::steady_clock::now();
+  translatePages(addresses.data(), count, pageShift, translated.data());
+  chrono::duration<double> translateTime = chrono::steady_clock::now() - start;
+  if(pages != translated){
+    cout << "\tERROR: translatePages disagrees with shifting each address\n";
+    exit(1);
+  }
+
+  cout << "Paged " << count << " references into " << BENCH_FRAMES << " frames\n";
+  cout << "\tone shift per address: " << shiftTime.count() << " s (" << count / shiftTime.count() << " addresses/s)\n";
+  cout << "\ttranslatePages:        " << translateTime.count() << " s (" << count / translateTime.count() << " addresses/s)\n";
+
+  ostream noOutput(NULL);
+  EventLog log(SUMMARY_LOG, 1, noOutput);
+  PagerPolicy policies[] = {FIFO_POLICY, LRU_POLICY, MFU_POLICY, RANDOM_POLICY, OPT_POLICY, WSCLOCK_POLICY, PFF_POLICY};
+  for(PagerPolicy policy : policies){
+    PagerEngine engine(policy, BENCH_FRAMES, BENCH_PAGES, BENCH_WINDOW);
+    vector<long long> upcoming;
+    if(engine.looksAhead()) engine.nextUses(pages, upcoming);
+    const long long *nextUse = upcoming.empty() ? NULL : upcoming.data();
+
+    int frame;
+    long long victim;
+    engine.reset();
+    start = chrono::steady_clock::now();
+    for(long long t = 0; t < count; t++) engine.reference(addresses[t] >> pageShift, frame, victim, nextUse ? nextUse[t] : NO_NEXT_USE);
+    chrono::duration<double> referenceTime = chrono::steady_clock::now() - start;
+    PagerStats referenceStats = engine.stats;
+
+    engine.reset();
+    start = chrono::steady_clock::now();
+    pagerKernels(policy, false).pageSlice(engine, 0, addresses.data(), count, nextUse, pageShift, log);
+    chrono::duration<double> kernelTime = chrono::steady_clock::now() - start;
+
+    if(memcmp(&referenceStats, &engine.stats, sizeof(PagerStats))){
+      cout << "\tERROR: " << policyName(policy) << " kernel disagrees with reference (" << engine.stats.faults << " vs "
+           << referenceStats.faults << " page faults)\n";
+      exit(1);
+    }
+    cout << "\t" << policyName(policy) << ": " << referenceStats.faults << " page faults, reference " << count / referenceTime.count()
+         << " references/s, kernel " << count / kernelTime.count() << " references/s, speedup " << referenceTime.count() / kernelTime.count() << "x\n";
+  }
+  return 0;
+}
@@ -0,0 +1,178 @@
+// FILE: profiler.cpp
+// A Bautista, B Franco, E Mora
+// OS, Fall 2023, Transy U
+//
+//	implementation of --profile
+//
+//	A thread's counters live in a thread_local ThreadProfile whose destructor adds them to profileTotals under profileMutex,
+//	so a worker's counts reach the totals as soon as it is joined, and printProfile adds in the calling thread's own
+//	--perf-events opens a group of a cache miss and a branch miss counter for each thread that reads them, counting only that
+//	thread in user space, so the whole group is read with one read() and the two counts always cover the same span
+//
+
+#include "profiler.h"
+#include <iostream>
+#include <iomanip>
+
+using namespace std;
+
+#ifndef NO_PROFILE
+
+#include <chrono>
+#include <cstring>
+#include <mutex>
+#include <errno.h>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+static const char *stageNames[PROFILE_STAGES] = {"load", "  address check", "schedule", "page", "  page table", "  victim"};
+
+bool profiling = false, profilingEvents = false;
+static ProfileCounters profileTotals;
+static mutex profileMutex;
+
+// opens the calling thread's perf_event group, returns its leader or -1
+static int openEventGroup(){
+  const uint64_t configs[PROFILE_EVENTS] = {PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+  int leader = -1;
+  for(int event = 0; event < PROFILE_EVENTS; event++){
+    struct perf_event_attr attributes;
+    memset(&attributes, 0, sizeof(attributes));
+    attributes.size = sizeof(attributes);
+    attributes.type = PERF_TYPE_HARDWARE;
+    attributes.config = configs[event];
+    attributes.read_format = PERF_FORMAT_GROUP;
+    attributes.exclude_kernel = 1;
+    attributes.exclude_hv = 1;
+    attributes.disabled = leader == -1;
+    int fd = syscall(SYS_perf_event_open, &attributes, 0, -1, leader, 0);
+    if(fd == -1){
+      if(leader != -1) close(leader);
+      return -1;
+    }
+    if(leader == -1) leader = fd;
+  }
+  ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+  return leader;
+}
+
+struct ThreadProfile{
+  ThreadProfile(){
+    memset(&counters, 0, sizeof(counters));
+    eventGroup = -1;
+    opened = false;
+  }
+
+  ~ThreadProfile(){
+    lock_guard<mutex> lock(profileMutex);
+    for(int stage = 0; stage < PROFILE_STAGES; stage++){
+      profileTotals.calls[stage] += counters.calls[stage];
+      profileTotals.cycles[stage] += counters.cycles[stage];
+      for(int event = 0; event < PROFILE_EVENTS; event++) profileTotals.events[stage][event] += counters.events[stage][event];
+    }
+    // the group's other counter is closed along with its leader
+    if(eventGroup != -1) close(eventGroup);
+  }
+
+  ProfileCounters counters;
+  int eventGroup;
+  bool opened;
+};
+
+static thread_local ThreadProfile threadProfile;
+
+// reads the calling thread's perf_event counters into values, opening them the first time, values are left 0 if they can't be
+static void readProfileEvents(uint64_t *values){
+  // the group comes back as the number of counters followed by each count
+  uint64_t group[1 + PROFILE_EVENTS];
+  if(!threadProfile.opened){
+    threadProfile.eventGroup = openEventGroup();
+    threadProfile.opened = true;
+  }
+  if(threadProfile.eventGroup == -1 || read(threadProfile.eventGroup, group, sizeof(group)) != (ssize_t)sizeof(group)){
+    for(int event = 0; event < PROFILE_EVENTS; event++) values[event] = 0;
+    return;
+  }
+  for(int event = 0; event < PROFILE_EVENTS; event++) values[event] = group[1 + event];
+}
+
+static uint64_t profileClock(){
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#else
+  return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+void ProfileScope::begin(){
+  if(profilingEvents && counted(stage)) readProfileEvents(startEvents);
+  start = profileClock();
+}
+
+void ProfileScope::end(){
+  uint64_t finish = profileClock();
+  ProfileCounters &counters = threadProfile.counters;
+  counters.calls[stage]++;
+  counters.cycles[stage] += finish - start;
+  if(profilingEvents && counted(stage)){
+    uint64_t endEvents[PROFILE_EVENTS];
+    readProfileEvents(endEvents);
+    for(int event = 0; event < PROFILE_EVENTS; event++) counters.events[stage][event] += endEvents[event] - startEvents[event];
+  }
+}
+
+bool startProfile(bool events){
+  memset(&profileTotals, 0, sizeof(profileTotals));
+  if(events){
+    // the main thread's group is opened here so that a machine without the counters is reported before the run rather than after it
+    threadProfile.eventGroup = openEventGroup();
+    threadProfile.opened = true;
+    if(threadProfile.eventGroup == -1){
+      cout << "\tERROR: " << PERF_EVENTS << " could not open the perf_event cache and branch miss counters (" << strerror(errno) << ")\n";
+      return false;
+    }
+  }
+  profilingEvents = events;
+  profiling = true;
+  return true;
+}
+
+void printProfile(ostream &out){
+  ProfileCounters totals;
+  {
+    lock_guard<mutex> lock(profileMutex);
+    totals = profileTotals;
+  }
+  const ProfileCounters &own = threadProfile.counters;
+  out << "Profile:\n";
+  out << "\t" << setw(18) << left << "Stage" << right << setw(14) << "Calls" << setw(18) << "Cycles" << setw(14) << "Cycles/call";
+  if(profilingEvents) out << setw(16) << "Cache misses" << setw(16) << "Branch misses";
+  out << "\n";
+  for(int stage = 0; stage < PROFILE_STAGES; stage++){
+    uint64_t calls = totals.calls[stage] + own.calls[stage], cycles = totals.cycles[stage] + own.cycles[stage];
+    out << "\t" << setw(18) << left << stageNames[stage] << right << setw(14) << calls << setw(18) << cycles
+        << setw(14) << fixed << setprecision(1) << (calls ? (double)cycles / calls : 0.0) << defaultfloat;
+    if(profilingEvents){
+      if(ProfileScope::counted((ProfileStage)stage)){
+        for(int event = 0; event < PROFILE_EVENTS; event++) out << setw(16) << totals.events[stage][event] + own.events[stage][event];
+      }
+      else out << setw(16) << "-" << setw(16) << "-";
+    }
+    out << "\n";
+  }
+  out << "\tA stage's cycles include those of the indented stages under it\n";
+}
+
+#else
+
+bool startProfile(bool){
+  cout << "\tERROR: babyOS was built with NO_PROFILE, so " << PROFILE << " is not available\n";
+  return false;
+}
+
+#endif // NO_PROFILE
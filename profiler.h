@@ -0,0 +1,104 @@
+// FILE: profiler.h
+// A Bautista, B Franco, E Mora
+// OS, Fall 2023, Transy U
+//
+//	interface for --profile, babyOS's own counters and scoped timers around the stages of a run
+//	A ProfileScope counts one call to its stage and adds the cycles it was alive for, read from the time stamp counter on x86
+//	and counted in nanoseconds elsewhere. Stages nest, so a stage's cycles include those of the stages inside it
+//		load				parsing and error checking one process of a text file (TraceLoader::nextProcess) or mapping a binary trace
+//			address check	error checking one address (addressErrorCheck)
+//		schedule			one scheduling decision, which process runs next and for how long (Scheduler::run)
+//		page				paging one process, or one slice of the timeline
+//			page table		finding a referenced page's frame through the TLB and page table
+//			victim			picking the frame a faulting page is loaded into (claimAs)
+//	With --perf-events the cache misses and branch misses of load, schedule, and page are also read from Linux perf_event
+//	counters around each call, the stages inside them happen too often to make a system call for each one
+//	Every thread counts into its own counters, which are added to the run's totals when it exits, so threads never contend for them
+//	Without --profile a scope costs a test of profiling, built with -DNO_PROFILE (make PROFILE_FLAGS=-DNO_PROFILE) it costs nothing
+//
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include "babyOS.h"
+#include <stdint.h>
+#include <ostream>
+
+using namespace std;
+
+enum ProfileStage{
+  LOAD_STAGE,
+  ADDRESS_CHECK_STAGE,
+  SCHEDULE_STAGE,
+  PAGE_STAGE,
+  PAGE_TABLE_STAGE,
+  VICTIM_STAGE,
+  PROFILE_STAGES
+};
+
+enum ProfileEvent{
+  CACHE_MISS_EVENT,
+  BRANCH_MISS_EVENT,
+  PROFILE_EVENTS
+};
+
+struct ProfileCounters{
+  uint64_t calls[PROFILE_STAGES], cycles[PROFILE_STAGES];
+  uint64_t events[PROFILE_STAGES][PROFILE_EVENTS];
+};
+
+#ifndef NO_PROFILE
+
+// set by startProfile before any thread but the main one is started and only read after that
+extern bool profiling, profilingEvents;
+
+// starts counting, with perf_event counters as well if events is true
+// returns false and prints the error if the counters can't be opened
+bool startProfile(bool events);
+
+// prints each stage's calls and cycles, and its events if they were counted, totalled over every thread that has exited and the calling one
+void printProfile(ostream &out);
+
+// only the test of profiling is inlined into the stages, the counting itself is kept out of line in profiler.cpp
+// so that a scope adds as little as possible to the code of a stage that isn't being profiled
+class ProfileScope{
+ public:
+  ProfileScope(ProfileStage stage){
+    this->stage = stage;
+    if(__builtin_expect(profiling, false)) begin();
+  }
+
+  ~ProfileScope(){
+    if(__builtin_expect(profiling, false)) end();
+  }
+
+  // true if stage's perf_event counters are read
+  static bool counted(ProfileStage stage){
+    return stage == LOAD_STAGE || stage == SCHEDULE_STAGE || stage == PAGE_STAGE;
+  }
+
+ private:
+  void begin();
+  void end();
+
+  ProfileStage stage;
+  uint64_t start;
+  uint64_t startEvents[PROFILE_EVENTS];
+};
+
+#else
+
+class ProfileScope{
+ public:
+  ProfileScope(ProfileStage){
+  }
+};
+
+bool startProfile(bool events);
+
+inline void printProfile(ostream &){
+}
+
+#endif // NO_PROFILE
+
+#endif // PROFILER_H
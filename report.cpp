@@ -0,0 +1,180 @@
+// FILE: report.cpp
+// A Bautista, B Franco, E Mora
+// OS, Fall 2023, Transy U
+//
+//	implementation of --report
+//
+//	Peak resident set size comes from getrusage, which only ever reports the peak for the whole process so far,
+//	so a phase's figure includes everything allocated by the phases before it
+//	The CSV form is one table: a record column says whether a row is the run's configuration, a phase, the totals, or a process,
+//	and the columns that don't apply to that kind of row are left empty, the TLB and steal columns come last so the earlier ones keep their place
+//
+
+#include "report.h"
+#include <cstring>
+#include <iomanip>
+#include <sys/resource.h>
+
+using namespace std;
+
+static const char *phaseNames[MAX_PHASES] = {"parse", "load", "schedule", "page"};
+
+void writeJsonString(ostream &out, const string &text){
+  out << '"';
+  for(size_t i = 0; i < text.size(); i++){
+    unsigned char c = text[i];
+    if(c == '"' || c == '\\') out << '\\' << c;
+    else if(c < 0x20) out << "\\u" << hex << setw(4) << setfill('0') << (int)c << dec << setfill(' ');
+    else out << c;
+  }
+  out << '"';
+}
+
+// writes text as a CSV field, quoting it if it contains a separator, quote, or line break
+static void writeCsvField(ostream &out, const string &text){
+  if(text.find_first_of(",\"\n\r") == string::npos){
+    out << text;
+    return;
+  }
+  out << '"';
+  for(size_t i = 0; i < text.size(); i++){
+    if(text[i] == '"') out << '"';
+    out << text[i];
+  }
+  out << '"';
+}
+
+RunReport::RunReport(){
+  for(int i = 0; i < MAX_PHASES; i++){
+    seconds[i] = 0;
+    peakKilobytes[i] = 0;
+  }
+}
+
+void RunReport::begin(ReportPhase phase){
+  started[phase] = chrono::steady_clock::now();
+}
+
+void RunReport::end(ReportPhase phase){
+  struct rusage usage;
+  chrono::duration<double> elapsed = chrono::steady_clock::now() - started[phase];
+  seconds[phase] += elapsed.count();
+  if(getrusage(RUSAGE_SELF, &usage) == 0) peakKilobytes[phase] = usage.ru_maxrss;
+}
+
+void RunReport::collect(const ProcessTable &table, const vector<PagerStats> &stats, const vector<long long> &wait, const vector<long long> &turnaround){
+  size_t count = table.size();
+  ProcessMetrics metrics;
+  processes.clear();
+  processes.reserve(count);
+  for(size_t i = 0; i < count; i++){
+    metrics.pid = table.pid[i];
+    metrics.references = stats[i].references;
+    metrics.faults = stats[i].faults;
+    metrics.hits = stats[i].hits;
+    metrics.evictions = stats[i].evictions;
+    metrics.tlbHits = stats[i].tlbHits;
+    metrics.tlbMisses = stats[i].tlbMisses;
+    metrics.steals = stats[i].steals;
+    metrics.wait = wait[i];
+    metrics.turnaround = turnaround[i];
+    processes.push_back(metrics);
+  }
+}
+
+void RunReport::write(ostream &out, const char *format, const vector<pair<string, string>> &configuration){
+  if(!strcmp(format, CSV_REPORT)) writeCsv(out, configuration);
+  else writeJson(out, configuration);
+  out.flush();
+}
+
+ProcessMetrics RunReport::totals(){
+  ProcessMetrics total;
+  memset(&total, 0, sizeof(total));
+  for(size_t i = 0; i < processes.size(); i++){
+    total.references += processes[i].references;
+    total.faults += processes[i].faults;
+    total.hits += processes[i].hits;
+    total.evictions += processes[i].evictions;
+    total.tlbHits += processes[i].tlbHits;
+    total.tlbMisses += processes[i].tlbMisses;
+    total.steals += processes[i].steals;
+    total.wait += processes[i].wait;
+    total.turnaround += processes[i].turnaround;
+  }
+  return total;
+}
+
+void RunReport::writeJsonConfiguration(ostream &out, const vector<pair<string, string>> &configuration){
+  out << "\"configuration\": {";
+  for(size_t i = 0; i < configuration.size(); i++){
+    out << (i ? ", " : "");
+    writeJsonString(out, configuration[i].first);
+    out << ": ";
+    writeJsonString(out, configuration[i].second);
+  }
+  out << "}";
+}
+
+void RunReport::writeJsonTotals(ostream &out){
+  ProcessMetrics total = totals();
+  double count = processes.empty() ? 1 : processes.size();
+  double tlbHitRate = total.tlbHits + total.tlbMisses ? (double)total.tlbHits / (total.tlbHits + total.tlbMisses) : 0;
+  out << "\"totals\": {\"processes\": " << processes.size() << ", \"references\": " << total.references
+      << ", \"faults\": " << total.faults << ", \"hits\": " << total.hits << ", \"evictions\": " << total.evictions
+      << ", \"tlbHits\": " << total.tlbHits << ", \"tlbMisses\": " << total.tlbMisses << ", \"tlbHitRate\": " << tlbHitRate << ", \"steals\": " << total.steals
+      << ", \"averageWait\": " << total.wait / count << ", \"averageTurnaround\": " << total.turnaround / count << "}";
+}
+
+void RunReport::writeLine(ostream &out, long long job, const vector<pair<string, string>> &configuration){
+  out << "{\"job\": " << job << ", ";
+  writeJsonConfiguration(out, configuration);
+  out << ", \"seconds\": {\"" << phaseNames[SCHEDULE_PHASE] << "\": " << seconds[SCHEDULE_PHASE]
+      << ", \"" << phaseNames[PAGE_PHASE] << "\": " << seconds[PAGE_PHASE] << "}, ";
+  writeJsonTotals(out);
+  out << "}\n";
+}
+
+void RunReport::writeJson(ostream &out, const vector<pair<string, string>> &configuration){
+  out << "{\n  ";
+  writeJsonConfiguration(out, configuration);
+  out << ",\n  \"phases\": {";
+  for(int i = 0; i < MAX_PHASES; i++){
+    out << (i ? ", " : "") << "\"" << phaseNames[i] << "\": {\"seconds\": " << seconds[i] << ", \"peakRssKb\": " << peakKilobytes[i] << "}";
+  }
+  out << "},\n  ";
+  writeJsonTotals(out);
+  out << ",\n";
+  out << "  \"processes\": [";
+  for(size_t i = 0; i < processes.size(); i++){
+    const ProcessMetrics &process = processes[i];
+    out << (i ? ",\n    " : "\n    ") << "{\"pid\": " << process.pid << ", \"references\": " << process.references
+        << ", \"faults\": " << process.faults << ", \"hits\": " << process.hits << ", \"evictions\": " << process.evictions
+        << ", \"tlbHits\": " << process.tlbHits << ", \"tlbMisses\": " << process.tlbMisses << ", \"steals\": " << process.steals << ", \"wait\": " << process.wait << ", \"turnaround\": " << process.turnaround << "}";
+  }
+  out << (processes.empty() ? "]\n}\n" : "\n  ]\n}\n");
+}
+
+void RunReport::writeCsv(ostream &out, const vector<pair<string, string>> &configuration){
+  ProcessMetrics total = totals();
+  out << "record,name,value,references,faults,hits,evictions,wait,turnaround,seconds,peakRssKb,tlbHits,tlbMisses,steals\n";
+  for(size_t i = 0; i < configuration.size(); i++){
+    out << "configuration,";
+    writeCsvField(out, configuration[i].first);
+    out << ",";
+    writeCsvField(out, configuration[i].second);
+    out << ",,,,,,,,,,,\n";
+  }
+  for(int i = 0; i < MAX_PHASES; i++){
+    out << "phase," << phaseNames[i] << ",,,,,,,," << seconds[i] << "," << peakKilobytes[i] << ",,,\n";
+  }
+  for(size_t i = 0; i < processes.size(); i++){
+    const ProcessMetrics &process = processes[i];
+    out << "process," << PID_FORM << process.pid << ",," << process.references << "," << process.faults << "," << process.hits
+        << "," << process.evictions << "," << process.wait << "," << process.turnaround << ",,," << process.tlbHits << "," << process.tlbMisses << "," << process.steals << "\n";
+  }
+  // the totals row holds the sums of references through evictions and the averages of wait and turnaround
+  double count = processes.empty() ? 1 : processes.size();
+  out << "total,," << processes.size() << "," << total.references << "," << total.faults << "," << total.hits << "," << total.evictions
+      << "," << total.wait / count << "," << total.turnaround / count << ",,," << total.tlbHits << "," << total.tlbMisses << "," << total.steals << "\n";
+}
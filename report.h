@@ -0,0 +1,77 @@
+// FILE: report.h
+// A Bautista, B Franco, E Mora
+// OS, Fall 2023, Transy U
+//
+//	interface for --report, which writes a run's metrics as JSON or CSV instead of babyOS's usual progress text
+//	Every process gets its page faults, hits, evictions, TLB hits and misses, steals, wait, and turnaround, the run gets their totals and averages,
+//	and each phase of the run gets the wall-clock time spent in it and the peak resident set size by the time it ended
+//	A phase may be entered many times, as loading and paging are when FCFS streams the input file, its time is the sum
+//	writeLine writes the same run on a single line of JSON without the processes, for --batch to print one line per job
+//
+
+#ifndef REPORT_H
+#define REPORT_H
+
+#include "babyOS.h"
+#include "pagerEngine.h"
+#include "traceFile.h"
+#include <chrono>
+#include <ostream>
+#include <vector>
+
+using namespace std;
+
+#define JSON_REPORT "json"
+#define CSV_REPORT "csv"
+
+enum ReportPhase{
+  PARSE_PHASE,
+  LOAD_PHASE,
+  SCHEDULE_PHASE,
+  PAGE_PHASE,
+  MAX_PHASES
+};
+
+struct ProcessMetrics{
+  int pid;
+  long long references, faults, hits, evictions, tlbHits, tlbMisses, steals, wait, turnaround;
+};
+
+// writes text as a JSON string, escaping what JSON requires
+void writeJsonString(ostream &out, const string &text);
+
+class RunReport{
+ public:
+  RunReport();
+
+  // starts timing phase
+  void begin(ReportPhase phase);
+  // stops timing phase, adding the time since begin to its total and recording the peak resident set size so far
+  void end(ReportPhase phase);
+
+  // fills in processes from the process table, each process's paging stats, and the scheduler's wait and turnaround, all in table order
+  void collect(const ProcessTable &table, const vector<PagerStats> &stats, const vector<long long> &wait, const vector<long long> &turnaround);
+
+  // writes the report to out in format, which inputErrorCheck has already made sure is JSON_REPORT or CSV_REPORT
+  // configuration lists the options the run was made with as name, value pairs
+  void write(ostream &out, const char *format, const vector<pair<string, string>> &configuration);
+
+  // writes job's configuration, schedule and page phase times, and totals to out as one line of JSON
+  void writeLine(ostream &out, long long job, const vector<pair<string, string>> &configuration);
+
+  vector<ProcessMetrics> processes;
+
+ private:
+  void writeJson(ostream &out, const vector<pair<string, string>> &configuration);
+  void writeCsv(ostream &out, const vector<pair<string, string>> &configuration);
+  // sums every process's metrics, pid is left 0
+  ProcessMetrics totals();
+  void writeJsonConfiguration(ostream &out, const vector<pair<string, string>> &configuration);
+  void writeJsonTotals(ostream &out);
+
+  double seconds[MAX_PHASES];
+  long peakKilobytes[MAX_PHASES];
+  chrono::steady_clock::time_point started[MAX_PHASES];
+};
+
+#endif // REPORT_H
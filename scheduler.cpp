@@ -0,0 +1,392 @@
+// FILE: scheduler.cpp
+// A Bautista, B Franco, E Mora
+// OS, Fall 2023, Transy U
+//
+//	implementation of babyOS's CPU scheduler
+//
+//	Arrivals are walked in order from a list of the processes sorted by arrival time. Whenever the CPU is free the process
+//	at the top of the ready heap runs until it finishes, or for preemptive SJF and Priority until the next arrival, or for
+//	RR until its quanta is up. A preempted process that is still at the top of the heap just keeps running, so its slices
+//	are merged and only a real switch to another process starts a new slice in the timeline
+//	RR keeps a plain queue instead of a heap, processes that arrive during a quanta are queued ahead of the process it preempts
+//	All of that state lives in the Scheduler between calls to run, so a schedule can be stopped at any time, saved to a snapshot
+//	for --checkpoint, and restored for --resume, possibly by a scheduler with other rules that then schedules the rest
+//
+
+#include "scheduler.h"
+#include "checkpoint.h"
+#include "profiler.h"
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <iomanip>
+
+using namespace std;
+
+SchedulerPolicy schedulerFromName(const char *schedulerType){
+  if(!strcmp(schedulerType, SHORTEST_JOB_FIRST)) return SJF_SCHEDULER;
+  if(!strcmp(schedulerType, PRIORITY)) return PRIORITY_SCHEDULER;
+  if(!strcmp(schedulerType, ROUND_ROBIN)) return RR_SCHEDULER;
+  return FCFS_SCHEDULER;
+}
+
+Scheduler::Scheduler(SchedulerPolicy policy, bool preemptive, int quanta){
+  this->policy = policy;
+  this->preemptive = preemptive;
+  this->quanta = quanta;
+  table = NULL;
+}
+
+bool Scheduler::runsAfter(int a, int b){
+  if(policy == SJF_SCHEDULER && remaining[a] != remaining[b]) return remaining[a] > remaining[b];
+  const int32_t *priority = table->priority.data(), *arrival = table->arrival.data();
+  if(policy == PRIORITY_SCHEDULER && priority[a] != priority[b]) return priority[a] > priority[b];
+  if(arrival[a] != arrival[b]) return arrival[a] > arrival[b];
+  return a > b;
+}
+
+void Scheduler::schedule(const ProcessTable &table, vector<ScheduleSlice> &timeline){
+  timeline.clear();
+  start(table);
+  run(timeline);
+}
+
+void Scheduler::start(const ProcessTable &table){
+  size_t count = table.size();
+  const int32_t *arrival = table.arrival.data();
+  this->table = &table;
+  remaining.assign(table.burst.begin(), table.burst.end());
+  wait.assign(count, 0);
+  turnaround.assign(count, 0);
+  arrivals.resize(count);
+  for(size_t i = 0; i < count; i++) arrivals[i] = i;
+  stable_sort(arrivals.begin(), arrivals.end(), [arrival](int a, int b){ return arrival[a] < arrival[b]; });
+  heap.clear();
+  roundRobin.clear();
+  nextArrival = finished = 0;
+  time = 0;
+  running = NO_PROCESS;
+  runEnd = 0;
+}
+
+void Scheduler::admit(){
+  while(nextArrival < arrivals.size() && table->arrival[arrivals[nextArrival]] <= time){
+    if(policy == RR_SCHEDULER) roundRobin.push_back(arrivals[nextArrival]);
+    else pushReady(arrivals[nextArrival]);
+    nextArrival++;
+  }
+}
+
+void Scheduler::pushReady(int process){
+  heap.push_back(process);
+  push_heap(heap.begin(), heap.end(), [this](int a, int b){ return runsAfter(a, b); });
+}
+
+void Scheduler::run(vector<ScheduleSlice> &timeline, long long until){
+  size_t count = arrivals.size();
+  while(finished < count && time < until){
+    if(running == NO_PROCESS){
+      ProfileScope scope(SCHEDULE_STAGE);
+      admit();
+      if(heap.empty() && roundRobin.empty()){
+        // the CPU is idle until the next process arrives
+        time = table->arrival[arrivals[nextArrival]];
+        continue;
+      }
+      if(policy == RR_SCHEDULER){
+        running = roundRobin.front();
+        roundRobin.pop_front();
+      }
+      else{
+        pop_heap(heap.begin(), heap.end(), [this](int a, int b){ return runsAfter(a, b); });
+        running = heap.back();
+        heap.pop_back();
+      }
+      runEnd = time + remaining[running];
+      if(policy == RR_SCHEDULER && runEnd > time + quanta) runEnd = time + quanta;
+      else if(preemptive && nextArrival < count && table->arrival[arrivals[nextArrival]] < runEnd) runEnd = table->arrival[arrivals[nextArrival]];
+    }
+
+    int process = running;
+    long long end = runEnd < until ? runEnd : until;
+    if(!timeline.empty() && timeline.back().process == process && timeline.back().start + timeline.back().length == time){
+      timeline.back().length += end - time;
+    }
+    else{
+      ScheduleSlice slice = {process, time, end - time};
+      timeline.push_back(slice);
+    }
+    remaining[process] -= end - time;
+    time = end;
+    if(time < runEnd) return;
+    running = NO_PROCESS;
+
+    if(remaining[process] == 0){
+      turnaround[process] = time - table->arrival[process];
+      wait[process] = turnaround[process] - table->burst[process];
+      finished++;
+    }
+    else if(policy == RR_SCHEDULER){
+      admit();
+      roundRobin.push_back(process);
+    }
+    else pushReady(process);
+  }
+}
+
+void Scheduler::save(SnapshotWriter &out){
+  out.put((int32_t)policy);
+  out.put((int32_t)preemptive);
+  out.put((int32_t)quanta);
+  out.put(time);
+  out.put((uint64_t)nextArrival);
+  out.put((uint64_t)finished);
+  out.put((int32_t)running);
+  out.put(runEnd);
+  out.put(remaining);
+  out.put(policy == RR_SCHEDULER ? vector<int>(roundRobin.begin(), roundRobin.end()) : heap);
+  out.put(wait);
+  out.put(turnaround);
+}
+
+bool Scheduler::restore(const ProcessTable &table, SnapshotReader &in){
+  int32_t savedPolicy = 0, savedPreemptive = 0, savedQuanta = 0, savedRunning = NO_PROCESS;
+  uint64_t savedNextArrival = 0, savedFinished = 0;
+  vector<int> ready;
+  size_t count = table.size();
+
+  start(table);
+  in.get(savedPolicy);
+  in.get(savedPreemptive);
+  in.get(savedQuanta);
+  in.get(time);
+  in.get(savedNextArrival);
+  in.get(savedFinished);
+  in.get(savedRunning);
+  in.get(runEnd);
+  in.get(remaining);
+  in.get(ready);
+  in.get(wait);
+  in.get(turnaround);
+  // a snapshot that hashes correctly can still have been written for another shape of table, which would index past it
+  if(in.failed || remaining.size() != count || wait.size() != count || turnaround.size() != count || ready.size() > count ||
+     savedNextArrival > count || savedFinished > count || (savedRunning != NO_PROCESS && (savedRunning < 0 || (size_t)savedRunning >= count))){
+    start(table);
+    return false;
+  }
+  for(size_t i = 0; i < ready.size(); i++){
+    if(ready[i] < 0 || (size_t)ready[i] >= count){
+      start(table);
+      return false;
+    }
+  }
+  nextArrival = savedNextArrival;
+  finished = savedFinished;
+  running = savedRunning;
+
+  if(savedPolicy == policy && (bool)savedPreemptive == preemptive && savedQuanta == quanta){
+    if(policy == RR_SCHEDULER) roundRobin.assign(ready.begin(), ready.end());
+    else heap = ready;
+    return true;
+  }
+  // a different scheduler takes over at the snapshot, as if the running process had just been preempted
+  if(running != NO_PROCESS) ready.push_back(running);
+  running = NO_PROCESS;
+  if(policy == RR_SCHEDULER){
+    // a heap's array is in no useful order, so the ready processes are queued in the order they arrived
+    if(savedPolicy != RR_SCHEDULER){
+      const int32_t *arrival = table.arrival.data();
+      sort(ready.begin(), ready.end(), [arrival](int a, int b){ return arrival[a] != arrival[b] ? arrival[a] < arrival[b] : a < b; });
+    }
+    roundRobin.assign(ready.begin(), ready.end());
+  }
+  else for(size_t i = 0; i < ready.size(); i++) pushReady(ready[i]);
+  return true;
+}
+
+void Scheduler::print(const ProcessTable &table, const vector<ScheduleSlice> &timeline, ostream &out){
+  size_t count = table.size();
+  long long totalWait = 0, totalTurnaround = 0;
+  out << "\tTimeline:\n";
+  for(size_t i = 0; i < timeline.size(); i++){
+    out << "\t\t" << PID_FORM << table.pid[timeline[i].process] << " runs from " << timeline[i].start
+        << " to " << timeline[i].start + timeline[i].length << "\n";
+  }
+  out << "\t" << setw(12) << left << "Process" << setw(12) << "Wait" << "Turnaround\n" << right;
+  for(size_t i = 0; i < count; i++){
+    out << "\t" << PID_FORM << setw(10) << left << table.pid[i] << setw(12) << wait[i] << turnaround[i] << "\n" << right;
+    totalWait += wait[i];
+    totalTurnaround += turnaround[i];
+  }
+  if(count){
+    out << "\tAverage wait: " << (double)totalWait / count << "\n";
+    out << "\tAverage turnaround: " << (double)totalTurnaround / count << "\n";
+  }
+}
+
+bool pageSchedule(const vector<ScheduleSlice> &timeline, const ProcessTable &table,
+                  PagerPolicy policy, int frames, long long pages, int window, int tlbEntries, int tlbWays, int pageShift, EventLog &log,
+                  vector<PagerStats> &stats, Checkpointer *checkpointer){
+  size_t count = table.size();
+  // a process only holds an engine from its first slice to its last, finished processes hand theirs back to spare
+  // and only holds its next-use index for OPT over the same span
+  vector<PagerEngine *> engines(count, (PagerEngine *)NULL), spare;
+  vector<long long> cursor(count, 0), pageNumbers;
+  vector<vector<long long>> upcoming(count);
+  const PagerKernels &kernels = pagerKernels(policy, log.logs(REFERENCE_LOG));
+  PagerStats empty;
+
+  memset(&empty, 0, sizeof(empty));
+  stats.assign(count, empty);
+
+  // indexes the references process has left for OPT, counted from its first reference like the ones its engine already holds
+  auto indexAhead = [&](int process){
+    const int64_t *addresses = table.processAddresses(process);
+    long long burst = table.burst[process], done = cursor[process];
+    pageNumbers.resize(burst - done);
+    for(long long t = 0; t < burst - done; t++) pageNumbers[t] = addresses[done + t] >> pageShift;
+    engines[process]->nextUses(pageNumbers, upcoming[process]);
+    if(done){
+      // the references already paged are never read again
+      upcoming[process].insert(upcoming[process].begin(), done, NO_NEXT_USE);
+      for(long long t = done; t < burst; t++){
+        if(upcoming[process][t] != NO_NEXT_USE) upcoming[process][t] += done;
+      }
+    }
+  };
+
+  // a resumed run picks every process up where the snapshot left it, along with the engine it was paging with if it was part way through
+  if(checkpointer && checkpointer->resuming()){
+    SnapshotReader &in = checkpointer->pagerState();
+    in.get(cursor);
+    in.get(stats);
+    bool fits = checkpointer->cursorsFit(cursor) && stats.size() == count;
+    for(size_t process = 0; fits && process < count; process++){
+      if(cursor[process] == 0 || cursor[process] == table.burst[process]) continue;
+      engines[process] = new PagerEngine(policy, frames, pages, window, tlbEntries, tlbWays);
+      fits = engines[process]->restore(in);
+      if(fits && engines[process]->looksAhead()) indexAhead(process);
+    }
+    if(!checkpointer->pagerRestored(fits)){
+      for(size_t i = 0; i < count; i++) delete engines[i];
+      return false;
+    }
+  }
+
+  for(size_t i = 0; i < timeline.size(); i++){
+    int process = timeline[i].process, pid = table.pid[process];
+    long long burst = table.burst[process];
+    if(!engines[process]){
+      if(spare.empty()) engines[process] = new PagerEngine(policy, frames, pages, window, tlbEntries, tlbWays);
+      else{
+        engines[process] = spare.back();
+        spare.pop_back();
+      }
+      engines[process]->reset();
+      if(engines[process]->looksAhead()) indexAhead(process);
+    }
+
+    if(log.logs(PROCESS_LOG)){
+      log << '\t' << PID_FORM << pid << " runs from " << timeline[i].start << " to " << timeline[i].start + timeline[i].length << '\n';
+    }
+    // a checkpoint can fall part way through a slice, which is then paged in two pieces on either side of it
+    for(long long done = 0; done < timeline[i].length;){
+      long long length = checkpointer ? checkpointer->chunk(timeline[i].length - done) : timeline[i].length;
+      const int64_t *address = table.processAddresses(process) + cursor[process];
+      const long long *nextUse = upcoming[process].empty() ? NULL : upcoming[process].data() + cursor[process];
+      kernels.pageSlice(*engines[process], pid, address, length, nextUse, pageShift, log);
+      cursor[process] += length;
+      done += length;
+
+      if(cursor[process] == burst){
+        printPagerSummary(engines[process]->stats, pid, log);
+        stats[process] = engines[process]->stats;
+        spare.push_back(engines[process]);
+        engines[process] = NULL;
+        vector<long long>().swap(upcoming[process]);
+      }
+      if(checkpointer && checkpointer->paged(length)){
+        SnapshotWriter &out = checkpointer->begin(timeline[i].start + done);
+        out.put(cursor);
+        out.put(stats);
+        for(size_t j = 0; j < count; j++){
+          if(engines[j]) engines[j]->save(out);
+        }
+        checkpointer->commit();
+      }
+    }
+  }
+  for(size_t i = 0; i < count; i++) delete engines[i];
+  for(size_t i = 0; i < spare.size(); i++) delete spare[i];
+  return true;
+}
+
+bool pageScheduleGlobal(const vector<ScheduleSlice> &timeline, const ProcessTable &table,
+                        PagerPolicy policy, int frames, long long pages, int window, int pageShift, EventLog &log, vector<PagerStats> &stats,
+                        Checkpointer *checkpointer){
+  size_t count = table.size();
+  GlobalPager pager(policy, frames, window, count);
+  GlobalSliceKernel pageSlice = globalSliceKernel(policy, log.logs(REFERENCE_LOG));
+  vector<long long> cursor(count, 0), pageNumbers;
+  vector<vector<long long>> upcoming(count);
+
+  // resumed under another scheduler, the next uses already in the frames are times on the old timeline until their pages are referenced again
+  if(checkpointer && checkpointer->resuming()){
+    SnapshotReader &in = checkpointer->pagerState();
+    in.get(cursor);
+    bool fits = checkpointer->cursorsFit(cursor) && pager.restore(in);
+    if(!checkpointer->pagerRestored(fits)) return false;
+  }
+
+  // a process's next use of a page is found in its own references and then converted to the time on the timeline it runs at,
+  // the CPU only runs one process at a time so those times order every process's references at once
+  // a resumed run only indexes the references each process has left, the ones before its cursor are never read
+  if(policy == OPT_POLICY){
+    vector<vector<long long>> when(count);
+    PageTable seen(pages);
+    for(size_t i = 0; i < timeline.size(); i++){
+      vector<long long> &times = when[timeline[i].process];
+      for(long long t = 0; t < timeline[i].length; t++) times.push_back(timeline[i].start + t);
+    }
+    for(size_t process = 0; process < count; process++){
+      const int64_t *addresses = table.processAddresses(process);
+      long long burst = table.burst[process], done = cursor[process];
+      pageNumbers.resize(burst - done);
+      for(long long t = 0; t < burst - done; t++) pageNumbers[t] = addresses[done + t] >> pageShift;
+      nextUses(seen, pageNumbers, upcoming[process]);
+      for(long long t = 0; t < burst - done; t++){
+        if(upcoming[process][t] != NO_NEXT_USE) upcoming[process][t] = when[process][upcoming[process][t]];
+      }
+      if(done) upcoming[process].insert(upcoming[process].begin(), done, NO_NEXT_USE);
+      vector<long long>().swap(when[process]);
+    }
+  }
+
+  for(size_t i = 0; i < timeline.size(); i++){
+    int process = timeline[i].process, pid = table.pid[process];
+    if(log.logs(PROCESS_LOG)){
+      log << '\t' << PID_FORM << pid << " runs from " << timeline[i].start << " to " << timeline[i].start + timeline[i].length << '\n';
+    }
+    for(long long done = 0; done < timeline[i].length;){
+      long long length = checkpointer ? checkpointer->chunk(timeline[i].length - done) : timeline[i].length;
+      const int64_t *address = table.processAddresses(process) + cursor[process];
+      const long long *nextUse = upcoming[process].empty() ? NULL : upcoming[process].data() + cursor[process];
+      pageSlice(pager, table, process, address, length, nextUse, pageShift, log);
+      cursor[process] += length;
+      done += length;
+
+      if(cursor[process] == table.burst[process]){
+        printPagerSummary(pager.stats[process], pid, log);
+        log << '\t' << pager.stats[process].steals << " frames stolen from other processes\n";
+      }
+      if(checkpointer && checkpointer->paged(length)){
+        SnapshotWriter &out = checkpointer->begin(timeline[i].start + done);
+        out.put(cursor);
+        pager.save(out);
+        checkpointer->commit();
+      }
+    }
+  }
+  stats = pager.stats;
+  return true;
+}
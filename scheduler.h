@@ -0,0 +1,123 @@
+// FILE: scheduler.h
+// A Bautista, B Franco, E Mora
+// OS, Fall 2023, Transy U
+//
+//	interface for babyOS's CPU scheduler, which replaces the G4CPU's SJF, Priority, and RR
+//	Processes are admitted from a queue of arrival events into a binary heap keyed on the scheduler type, so every
+//	decision costs O(log n) in the number of ready processes
+//		SJF			shortest remaining burst first, preemptive SJF is shortest remaining time first
+//		Priority	lowest priority number first, MIN_PRIORITY being the most important
+//		RR			first come first serve for at most --quanta time units at a time
+//	Ties go to the process that arrived first and then to the one that appears first in the input file
+//	The result is a timeline of slices which pageSchedule then replays through the pager one address per time unit
+//
+
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include "babyOS.h"
+#include "globalPager.h"
+#include "pagerEngine.h"
+#include "snapshot.h"
+#include "traceFile.h"
+#include <deque>
+#include <ostream>
+#include <vector>
+
+using namespace std;
+
+class Checkpointer;
+
+// the running process of a scheduler between slices
+#define NO_PROCESS -1
+
+enum SchedulerPolicy{
+  FCFS_SCHEDULER,
+  SJF_SCHEDULER,
+  PRIORITY_SCHEDULER,
+  RR_SCHEDULER
+};
+
+// process ran uninterrupted for length time units starting at start, process is an index into the process table
+struct ScheduleSlice{
+  int process;
+  long long start, length;
+};
+
+// returns the scheduler named by schedulerType, which commandErrorCheck has already made sure is valid
+SchedulerPolicy schedulerFromName(const char *schedulerType);
+
+class Scheduler{
+ public:
+  Scheduler(SchedulerPolicy policy, bool preemptive, int quanta);
+
+  // schedules every process in table, replacing timeline with the slices they ran in
+  // wait and turnaround are filled in for every process
+  void schedule(const ProcessTable &table, vector<ScheduleSlice> &timeline);
+
+  // starts a schedule of every process in table at time 0, before any of them have arrived
+  // the scheduler only reads table's arrival, burst, and priority columns, table has to outlive it
+  void start(const ProcessTable &table);
+
+  // schedules from where the scheduler left off until time until or until every process has finished, adding the slices to timeline
+  // a process still running at until is cut off there and runs out the rest of its slice when run is next called
+  // wait and turnaround are filled in for each process as it finishes
+  void run(vector<ScheduleSlice> &timeline, long long until = LLONG_MAX);
+
+  // writes the clock, the ready queue, the running process, and what each process has left to run to out
+  void save(SnapshotWriter &out);
+
+  // picks up the schedule save wrote for the same processes of table
+  // if the scheduler that saved it had another policy, preemption, or quanta, the process it was running is preempted
+  // and the ready processes are queued by this one's rules, so the rest of the schedule is this scheduler's own
+  // returns false, leaving the scheduler as start left it, if in ran out or what it held doesn't fit table's processes
+  bool restore(const ProcessTable &table, SnapshotReader &in);
+
+  // prints the timeline and each process's wait and turnaround followed by their averages
+  void print(const ProcessTable &table, const vector<ScheduleSlice> &timeline, ostream &out);
+
+  vector<long long> wait, turnaround;
+
+ private:
+  // true if the ready process a should run after the ready process b, which makes the heap's top the next to run
+  bool runsAfter(int a, int b);
+  // admits every process that has arrived by time into the ready heap or queue
+  void admit();
+  void pushReady(int process);
+
+  SchedulerPolicy policy;
+  bool preemptive;
+  int quanta;
+  const ProcessTable *table;
+  vector<long long> remaining;
+  // every process in order of arrival, the next of them to arrive, and how many have finished
+  vector<int> arrivals;
+  size_t nextArrival, finished;
+  // RR keeps roundRobin, every other policy heap
+  vector<int> heap;
+  deque<int> roundRobin;
+  long long time;
+  // the process on the CPU when run was cut off and when its slice ends, NO_PROCESS between slices
+  int running;
+  long long runEnd;
+};
+
+// pages each process's addresses in the order the timeline ran them, one address per time unit, logging each slice and reference to log
+// each process gets its own frames under policy for as long as it is running, the same as it would paging in file order
+// for OPT a process's addresses are indexed with nextUses when it first runs
+// stats is replaced with each process's paging stats in table order
+// with a checkpointer the run is checkpointed as it goes, and if it is resuming the pager is restored from its snapshot first
+// and timeline only has to be the rest of the schedule
+// returns false and prints the error if the snapshot being resumed doesn't hold a pager that fits table
+bool pageSchedule(const vector<ScheduleSlice> &timeline, const ProcessTable &table,
+                  PagerPolicy policy, int frames, long long pages, int window, int tlbEntries, int tlbWays, int pageShift, EventLog &log,
+                  vector<PagerStats> &stats, Checkpointer *checkpointer = NULL);
+
+// pages the timeline the same way as pageSchedule except that every process shares one GlobalPager of frames frames for --global-frames
+// a process's summary also says how many frames it stole from other processes
+// for OPT every reference's next use is the time on the timeline that its process next references the page
+bool pageScheduleGlobal(const vector<ScheduleSlice> &timeline, const ProcessTable &table,
+                        PagerPolicy policy, int frames, long long pages, int window, int pageShift, EventLog &log, vector<PagerStats> &stats,
+                        Checkpointer *checkpointer = NULL);
+
+#endif // SCHEDULER_H
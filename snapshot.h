@@ -0,0 +1,103 @@
+// FILE: snapshot.h
+// A Bautista, B Franco, E Mora
+// OS, Fall 2023, Transy U
+//
+//	interface for the binary snapshots behind --checkpoint and --resume (checkpoint.h)
+//	Every class whose state is checkpointed writes it with save and reads it back with restore, in the same order, through a
+//	SnapshotWriter that appends to a buffer in memory and a SnapshotReader that reads that buffer back. Values are copied in the
+//	native byte order of the machine, as a binary trace's are, and a vector is written as its size followed by its elements
+//	A class only saves what changes as it runs, whatever it was constructed from has to be the same again when it is restored,
+//	which Checkpointer checks against the snapshot's header before anything is restored
+//
+
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <stdint.h>
+#include <string.h>
+#include <type_traits>
+#include <vector>
+
+using namespace std;
+
+// FNV-1a, which is enough to tell a snapshot's body or a trace's process table apart from a different or damaged one
+#define SNAPSHOT_HASH_START 14695981039346656037ULL
+#define SNAPSHOT_HASH_PRIME 1099511628211ULL
+
+inline uint64_t snapshotHash(const void *data, size_t size, uint64_t hash = SNAPSHOT_HASH_START){
+  const unsigned char *bytes = (const unsigned char *)data;
+  for(size_t i = 0; i < size; i++) hash = (hash ^ bytes[i]) * SNAPSHOT_HASH_PRIME;
+  return hash;
+}
+
+class SnapshotWriter{
+ public:
+  template<class T>
+  void put(const T &value){
+    static_assert(is_trivially_copyable<T>::value, "only plain values can be written to a snapshot");
+    const char *bytes = (const char *)&value;
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+  }
+
+  template<class T>
+  void put(const vector<T> &values){
+    static_assert(is_trivially_copyable<T>::value, "only vectors of plain values can be written to a snapshot");
+    put((uint64_t)values.size());
+    const char *bytes = (const char *)values.data();
+    buffer.insert(buffer.end(), bytes, bytes + values.size() * sizeof(T));
+  }
+
+  vector<char> buffer;
+};
+
+class SnapshotReader{
+ public:
+  SnapshotReader(){
+    open(NULL, 0);
+  }
+
+  // reads from the size bytes at data, which have to outlive the reader
+  void open(const char *data, size_t size){
+    this->data = data;
+    this->size = size;
+    position = 0;
+    failed = false;
+  }
+
+  // a read past the end sets failed and leaves value as it was
+  template<class T>
+  void get(T &value){
+    if(failed || size - position < sizeof(T)){
+      failed = true;
+      return;
+    }
+    memcpy((void *)&value, data + position, sizeof(T));
+    position += sizeof(T);
+  }
+
+  template<class T>
+  void get(vector<T> &values){
+    uint64_t count = 0;
+    get(count);
+    if(failed || count > (size - position) / sizeof(T)){
+      failed = true;
+      return;
+    }
+    values.resize(count);
+    memcpy((void *)values.data(), data + position, count * sizeof(T));
+    position += count * sizeof(T);
+  }
+
+  // true once every byte has been read
+  bool finished(){
+    return position == size;
+  }
+
+  bool failed;
+
+ private:
+  const char *data;
+  size_t size, position;
+};
+
+#endif // SNAPSHOT_H
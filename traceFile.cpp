@@ -0,0 +1,281 @@
+// FILE: traceFile.cpp
+// A Bautista, B Franco, E Mora
+// OS, Fall 2023, Transy U
+//
+//	implementation of the binary trace converter and loader
+//
+//	The converter streams the text file through TraceLoader so it runs in the same bounded memory as a normal run.
+//	Since the process table has to come before the addresses but its size isn't known until the whole file is read,
+//	addresses are spooled to an anonymous tmpfile() and copied in behind the table at the end
+//	The loader maps the file read-only and never copies it, a PCB or a ProcessTable filled from it points straight into the mapping
+//
+
+#include "traceFile.h"
+#include "traceLoader.h"
+#include "profiler.h"
+#include <iostream>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+
+bool isTraceFile(const char *fileName){
+  char magic[TRACE_MAGIC_SIZE];
+  FILE *file = fopen(fileName, "rb");
+  if(!file) return false;
+  bool match = fread(magic, 1, TRACE_MAGIC_SIZE, file) == TRACE_MAGIC_SIZE && !memcmp(magic, TRACE_MAGIC, TRACE_MAGIC_SIZE);
+  fclose(file);
+  return match;
+}
+
+bool convertTrace(const char *inputName, const char *outputName, int pageSize, long long pages){
+  TraceLoader loader;
+  TraceHeader header;
+  TraceRecord record;
+  vector<TraceRecord> records;
+  PCB block;
+  bool spoolError = false;
+
+  if(!loader.open(inputName)){
+    cout << "\tERROR: File not opened\n";
+    return false;
+  }
+  FILE *spool = tmpfile();
+  if(!spool){
+    cout << "\tERROR: Could not create a temporary file for conversion\n";
+    return false;
+  }
+
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, TRACE_MAGIC, TRACE_MAGIC_SIZE);
+  header.version = TRACE_VERSION;
+  while(loader.nextProcess(block, pageSize, pages)){
+    record.pid = block.pid;
+    record.arrival = block.arrival;
+    record.burst = block.burst;
+    record.priority = block.priority;
+    record.offset = header.addressCount;
+    records.push_back(record);
+
+    for(int i = 0; i < block.burst; i++){
+      if(block.addresses[i] > header.maxAddress) header.maxAddress = block.addresses[i];
+    }
+    if(fwrite(block.addresses, sizeof(int64_t), block.burst, spool) != (size_t)block.burst){
+      spoolError = true;
+      break;
+    }
+    header.addressCount += block.burst;
+  }
+  loader.close();
+  if(loader.failed()){
+    fclose(spool);
+    return false;
+  }
+  // the spool is flushed before it is read back so that a write that only fails once it leaves the stdio buffer is still caught
+  if(spoolError || fflush(spool) != 0){
+    cout << "\tERROR: Could not write the temporary file for conversion (" << strerror(errno) << ")\n";
+    fclose(spool);
+    return false;
+  }
+  header.processCount = records.size();
+
+  FILE *output = fopen(outputName, "wb");
+  if(!output){
+    cout << "\tERROR: Could not open " << outputName << " for writing\n";
+    fclose(spool);
+    return false;
+  }
+  bool error = fwrite(&header, sizeof(header), 1, output) != 1 ||
+    fwrite(records.data(), sizeof(TraceRecord), records.size(), output) != records.size();
+
+  // copies the spooled addresses in behind the process table
+  char copyBuffer[1 << 16];
+  size_t bytes;
+  rewind(spool);
+  while(!error && (bytes = fread(copyBuffer, 1, sizeof(copyBuffer), spool)) > 0){
+    if(fwrite(copyBuffer, 1, bytes, output) != bytes) error = true;
+  }
+  if(ferror(spool)) error = true;
+  fclose(spool);
+  if(fclose(output) != 0) error = true;
+  if(error){
+    cout << "\tERROR: Could not write " << outputName << "\n";
+    return false;
+  }
+  return true;
+}
+
+ProcessTable::ProcessTable(){
+  addresses = NULL;
+}
+
+void ProcessTable::clear(){
+  pid.clear();
+  arrival.clear();
+  burst.clear();
+  priority.clear();
+  offset.clear();
+  arena.clear();
+  addresses = NULL;
+}
+
+void ProcessTable::push(const PCB &block, bool keepAddresses){
+  pid.push_back(block.pid);
+  arrival.push_back(block.arrival);
+  burst.push_back(block.burst);
+  priority.push_back(block.priority);
+  offset.push_back(keepAddresses ? arena.size() : 0);
+  if(keepAddresses){
+    arena.insert(arena.end(), block.addresses, block.addresses + block.burst);
+    // the arena may have moved as it grew
+    addresses = arena.data();
+  }
+}
+
+bool readTrace(TraceLoader &loader, int pageSize, long long pages, ProcessTable &table){
+  PCB block;
+  table.clear();
+  while(loader.nextProcess(block, pageSize, pages)) table.push(block, true);
+  return !loader.failed();
+}
+
+MappedTrace::MappedTrace(){
+  mapping = MAP_FAILED;
+  mappingSize = 0;
+  nextIndex = 0;
+  header = NULL;
+  records = NULL;
+  addressArray = NULL;
+}
+
+MappedTrace::~MappedTrace(){
+  close();
+}
+
+bool MappedTrace::open(const char *fileName, int pageSize, long long pages){
+  ProfileScope scope(LOAD_STAGE);
+  struct stat fileStat;
+  close();
+
+  int fd = ::open(fileName, O_RDONLY);
+  if(fd == -1){
+    cout << "\tERROR: File not opened\n";
+    return false;
+  }
+  if(fstat(fd, &fileStat) == -1 || (size_t)fileStat.st_size < sizeof(TraceHeader)){
+    cout << "\tERROR: " << fileName << " is not a valid binary trace\n";
+    ::close(fd);
+    return false;
+  }
+  mappingSize = fileStat.st_size;
+  mapping = mmap(NULL, mappingSize, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if(mapping == MAP_FAILED){
+    cout << "\tERROR: " << fileName << " could not be memory mapped\n";
+    return false;
+  }
+
+  header = (const TraceHeader *)mapping;
+  if(header->version != TRACE_VERSION){
+    cout << "\tERROR: " << fileName << " is binary trace version " << header->version << ", babyOS reads version " << TRACE_VERSION << ". Please convert it again\n";
+    close();
+    return false;
+  }
+  // the counts are bounded by what the file could hold before they are multiplied, so a corrupt header can't wrap the size around
+  // to one that matches, and each process's addresses are checked by subtracting from addressCount rather than adding to offset
+  size_t bodySize = mappingSize - sizeof(TraceHeader);
+  if(header->processCount > bodySize / sizeof(TraceRecord) || header->addressCount > bodySize / sizeof(int64_t) ||
+     sizeof(TraceHeader) + header->processCount * sizeof(TraceRecord) + header->addressCount * sizeof(int64_t) != mappingSize){
+    cout << "\tERROR: " << fileName << " is truncated or corrupt\n";
+    close();
+    return false;
+  }
+  records = (const TraceRecord *)(header + 1);
+  addressArray = (const int64_t *)(records + header->processCount);
+  // the mapping is trusted no further than a text file would be, every field the converter checked is checked again here
+  // except the addresses' bound, which is checked once against the largest of them below
+  for(size_t i = 0; i < header->processCount; i++){
+    const TraceRecord &record = records[i];
+    if(record.burst <= 0 || (uint64_t)record.burst > header->addressCount || record.offset > header->addressCount - record.burst ||
+       record.pid < 0 || record.arrival < 0 || record.priority < MIN_PRIORITY || record.priority > MAX_PRIORITY){
+      cout << "\tERROR: " << fileName << " is truncated or corrupt\n";
+      close();
+      return false;
+    }
+  }
+
+  // one pass over the addresses, cheap next to paging them, so that the header's largest address can be relied on for the bound
+  int64_t smallest = 0, largest = 0;
+  for(size_t i = 0; i < header->addressCount; i++){
+    if(addressArray[i] < smallest) smallest = addressArray[i];
+    if(addressArray[i] > largest) largest = addressArray[i];
+  }
+  if(smallest < 0 || largest != header->maxAddress){
+    cout << "\tERROR: " << fileName << " is corrupt, its addresses do not match its header\n";
+    close();
+    return false;
+  }
+
+  // the addresses were already error checked at conversion time, only the bound may have changed since then
+  if(header->processCount && (header->maxAddress / pageSize) >= pages){
+    cout << "\tERROR: Address " << header->maxAddress << " of " << fileName << " cannot exist within " << pages << " " << pageSize << " byte pages\n";
+    close();
+    return false;
+  }
+  madvise(mapping, mappingSize, MADV_SEQUENTIAL);
+  nextIndex = 0;
+  return true;
+}
+
+bool MappedTrace::nextProcess(PCB &block){
+  if(!header || nextIndex == header->processCount) return false;
+  const TraceRecord &record = records[nextIndex];
+  block.pid = record.pid;
+  block.arrival = record.arrival;
+  block.burst = record.burst;
+  block.priority = record.priority;
+  block.addresses = addressArray + record.offset;
+  nextIndex++;
+  return true;
+}
+
+size_t MappedTrace::processCount(){
+  return header ? header->processCount : 0;
+}
+
+void MappedTrace::fillTable(ProcessTable &table){
+  size_t count = processCount();
+  table.clear();
+  table.pid.resize(count);
+  table.arrival.resize(count);
+  table.burst.resize(count);
+  table.priority.resize(count);
+  table.offset.resize(count);
+  for(size_t i = 0; i < count; i++){
+    table.pid[i] = records[i].pid;
+    table.arrival[i] = records[i].arrival;
+    table.burst[i] = records[i].burst;
+    table.priority[i] = records[i].priority;
+    table.offset[i] = records[i].offset;
+  }
+  table.addresses = addressArray;
+}
+
+int64_t MappedTrace::maxAddress(){
+  return header->maxAddress;
+}
+
+void MappedTrace::close(){
+  if(mapping != MAP_FAILED) munmap(mapping, mappingSize);
+  mapping = MAP_FAILED;
+  mappingSize = 0;
+  header = NULL;
+  records = NULL;
+  addressArray = NULL;
+}
@@ -0,0 +1,118 @@
+// FILE: traceFile.h
+// A Bautista, B Franco, E Mora
+// OS, Fall 2023, Transy U
+//
+//	interface for babyOS's binary trace format, the converter that writes it from a text input file,
+//	and the loader that memory maps it for a run
+//
+//	A binary trace is laid out as
+//		TraceHeader
+//		TraceRecord[processCount]		the process table, in the order the processes appeared in the text file
+//		int64_t[addressCount]			every process's addresses packed back to back, located by TraceRecord.offset
+//	All values are stored in the native byte order of the machine that converted the file.
+//	Addresses are error checked once during conversion, the header keeps the largest address so that a run
+//	with a different --pages or --framesize only has to check that one address again
+//	Version 1 packed 32-bit addresses, version 2 widened them to 64 bits for address spaces up to MAX_ADDRESS_BITS
+//
+
+#ifndef TRACE_FILE_H
+#define TRACE_FILE_H
+
+#include "babyOS.h"
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+
+using namespace std;
+
+#define TRACE_MAGIC "BABYTRC"
+#define TRACE_MAGIC_SIZE 8
+#define TRACE_VERSION 2
+
+struct TraceHeader{
+  char magic[TRACE_MAGIC_SIZE];
+  uint32_t version;
+  // keeps maxAddress 8 byte aligned, always 0
+  uint32_t reserved;
+  int64_t maxAddress;
+  uint64_t processCount, addressCount;
+};
+
+struct TraceRecord{
+  int32_t pid, arrival, burst, priority;
+  // index of the process's first address in the packed address array
+  uint64_t offset;
+};
+
+// the process table a run schedules and pages from, one column per field, so that sorting and heaping processes on their
+// arrival, burst, or priority only pulls the column being compared into cache rather than every process's whole record
+// process i's burst[i] addresses start at addresses + offset[i], which points into arena for a text trace and into the mapping
+// for a binary one, so a table refers to its addresses where they already are and is never copied once it is filled
+struct ProcessTable{
+  ProcessTable();
+
+  size_t size() const{
+    return pid.size();
+  }
+
+  // returns the first of process index's burst addresses
+  const int64_t *processAddresses(size_t index) const{
+    return addresses + offset[index];
+  }
+
+  void clear();
+
+  // appends block's process to the table, and its addresses to arena if keepAddresses is true, otherwise its offset is left 0
+  // for a caller that pages block on its own and only schedules from the table
+  void push(const PCB &block, bool keepAddresses);
+
+  vector<int32_t> pid, arrival, burst, priority;
+  vector<uint64_t> offset;
+  const int64_t *addresses;
+  vector<int64_t> arena;
+};
+
+// returns true if fileName begins with TRACE_MAGIC and should be loaded as a binary trace
+bool isTraceFile(const char *fileName);
+
+// error checks the text input file inputName against pages of size pageSize and writes it to outputName as a binary trace
+// returns false if an error was found
+bool convertTrace(const char *inputName, const char *outputName, int pageSize, long long pages);
+
+class TraceLoader;
+
+// reads every remaining process from loader into table, their addresses packed back to back into its arena
+// for when the whole trace is needed at once, returns false if an error was found
+bool readTrace(TraceLoader &loader, int pageSize, long long pages, ProcessTable &table);
+
+class MappedTrace{
+ public:
+  MappedTrace();
+  ~MappedTrace();
+
+  // maps fileName and checks that it is a well formed binary trace whose addresses exist within pages of size pageSize
+  // every record and address is checked, so a damaged or crafted file is turned away rather than paged
+  // returns false and prints the error if it is not
+  bool open(const char *fileName, int pageSize, long long pages);
+
+  // hands the next process in the table back in block, its addresses point directly into the mapping
+  // returns false once every process has been handed out
+  bool nextProcess(PCB &block);
+
+  size_t processCount();
+  // fills table with the whole process table, its addresses left in the mapping, which has to outlive it
+  void fillTable(ProcessTable &table);
+  // returns the largest address in the trace, for checking it again against another --pages or --framesize
+  int64_t maxAddress();
+
+  void close();
+
+ private:
+  void *mapping;
+  size_t mappingSize, nextIndex;
+  const TraceHeader *header;
+  const TraceRecord *records;
+  const int64_t *addressArray;
+};
+
+#endif // TRACE_FILE_H
@@ -0,0 +1,162 @@
+// FILE: traceLoader.cpp
+// A Bautista, B Franco, E Mora
+// OS, Fall 2023, Transy U
+//
+//	implementation of the streaming trace loader
+//
+//	The input file is read LOADER_BUFFER_SIZE bytes at a time with read() rather than through an ifstream so
+//	that a multi-GB trace never has to be resident at once. A token that straddles two chunks is stitched
+//	together in carry before it is handed to the error checks.
+//	The error checks and messages are the same ones the driver used when it parsed the whole file up front,
+//	the only difference is that a process is handed back as soon as its addresses have been checked
+//	Tokens are handed to the error checks as string_views straight into the read buffer, each address is scanned once
+//	for its end and once by from_chars inside addressErrorCheck, which also hands back its value
+//
+
+#include "traceLoader.h"
+#include "inputParse.h"
+#include "profiler.h"
+#include <iostream>
+#include <cctype>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace std;
+
+TraceLoader::TraceLoader(){
+  fd = -1;
+  buffer = new char[LOADER_BUFFER_SIZE];
+  bufferLength = 0;
+  bufferIndex = 0;
+  error = false;
+  hasToken = false;
+}
+
+TraceLoader::~TraceLoader(){
+  close();
+  delete[] buffer;
+}
+
+bool TraceLoader::open(const char *fileName){
+  close();
+  fd = ::open(fileName, O_RDONLY);
+  if(fd == -1) return false;
+  this->fileName = fileName;
+  bufferLength = 0;
+  bufferIndex = 0;
+  error = false;
+  // primes the look-ahead token so nextProcess always starts on a process id
+  hasToken = nextToken(token);
+  return true;
+}
+
+bool TraceLoader::nextProcess(PCB &block, int pageSize, long long pages){
+  return nextProcess(block, pageSize, pages, addresses);
+}
+
+bool TraceLoader::nextProcess(PCB &block, int pageSize, long long pages, vector<int64_t> &addresses){
+  ProfileScope scope(LOAD_STAGE);
+  string_view field;
+  string arrival, burst, priority;
+  long long address;
+
+  if(error || !hasToken) return false;
+  if(idErrorCheck(token, block.pid)){
+    error = true;
+    return false;
+  }
+
+  // the fields are copied out since reading the next one may refill the buffer they point into
+  // a missing field is left empty so that loadErrorCheck reports it
+  if(nextToken(field)) arrival = field;
+  if(nextToken(field)) burst = field;
+  if(nextToken(field)) priority = field;
+  // a read error has already been printed, the fields it cut short aren't reported as well
+  if(error) return false;
+  if(loadErrorCheck(block.pid,arrival,burst,priority,block)){
+    error = true;
+    return false;
+  }
+  addresses.clear();
+
+  // if a pid is seen when trying to read in addresses, stop pushing to the address buffer
+  hasToken = nextToken(token);
+  while(hasToken && (int)addresses.size() < block.burst && token.find(PID_FORM) == string_view::npos){
+    if(addressErrorCheck(block.pid,pageSize,pages,token,address)){
+      error = true;
+      return false;
+    }
+    addresses.push_back(address);
+    hasToken = nextToken(token);
+  }
+  if(error) return false;
+  block.addresses = addresses.data();
+  if(block.burst != (int)addresses.size() || (hasToken && token.find(PID_FORM) == string_view::npos)){
+    cout << "\tERROR: " << PID_FORM << block.pid << " must have a number of memory addresses equivalent to its burst time [1 address: 1 time unit]\n";
+    error = true;
+    return false;
+  }
+  return true;
+}
+
+bool TraceLoader::failed(){
+  return error;
+}
+
+void TraceLoader::close(){
+  if(fd != -1) ::close(fd);
+  fd = -1;
+  hasToken = false;
+}
+
+bool TraceLoader::nextToken(string_view &token){
+  bool straddling = false;
+  while(true){
+    if(bufferIndex == bufferLength && !fillBuffer()){
+      // a token cut short by a read error is not handed back
+      if(error) return false;
+      token = carry;
+      return straddling;
+    }
+
+    // skips whitespace only while no part of the token has been seen, otherwise whitespace ends the token
+    if(!straddling){
+      while(bufferIndex < bufferLength && isspace((unsigned char)buffer[bufferIndex])) bufferIndex++;
+      if(bufferIndex == bufferLength) continue;
+    }
+    size_t start = bufferIndex;
+    while(bufferIndex < bufferLength && !isspace((unsigned char)buffer[bufferIndex])) bufferIndex++;
+    if(bufferIndex < bufferLength){
+      if(!straddling){
+        token = string_view(buffer + start, bufferIndex - start);
+        return true;
+      }
+      carry.append(buffer + start, bufferIndex - start);
+      token = carry;
+      return true;
+    }
+    // the token ran up against the end of this chunk so it is stitched together with the start of the next one
+    if(!straddling) carry.clear();
+    carry.append(buffer + start, bufferIndex - start);
+    straddling = true;
+  }
+}
+
+bool TraceLoader::fillBuffer(){
+  ssize_t bytes;
+  if(fd == -1) return false;
+  do{
+    bytes = read(fd, buffer, LOADER_BUFFER_SIZE);
+  }while(bytes == -1 && errno == EINTR);
+  bufferIndex = 0;
+  if(bytes == -1){
+    cout << "\tERROR: Could not read \"" << fileName << "\" (" << strerror(errno) << ")\n";
+    error = true;
+    bufferLength = 0;
+    return false;
+  }
+  bufferLength = bytes > 0 ? bytes : 0;
+  return bufferLength > 0;
+}
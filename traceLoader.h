@@ -0,0 +1,66 @@
+// FILE: traceLoader.h
+// A Bautista, B Franco, E Mora
+// OS, Fall 2023, Transy U
+//
+//	interface for the streaming trace loader that reads an input file in fixed-size chunks and
+//	hands back one error checked process at a time, so only the process currently being paged
+//	has its addresses held in memory no matter how large the input file is
+//
+
+#ifndef TRACE_LOADER_H
+#define TRACE_LOADER_H
+
+#include "babyOS.h"
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace std;
+
+// number of bytes read from the input file at a time
+#define LOADER_BUFFER_SIZE (1 << 20)
+
+class TraceLoader{
+ public:
+  TraceLoader();
+  ~TraceLoader();
+
+  // opens fileName for reading, returns false if it could not be opened
+  bool open(const char *fileName);
+
+  // parses the next process and its addresses into block, error checking the addresses against pages of size pageSize
+  // block's addresses point into a buffer the next call reuses
+  // returns false once the file is exhausted or an error was found, failed() tells the two apart
+  bool nextProcess(PCB &block, int pageSize, long long pages);
+
+  // the same, except that the addresses are parsed into addresses, which block's point into, rather than the loader's own buffer
+  bool nextProcess(PCB &block, int pageSize, long long pages, vector<int64_t> &addresses);
+
+  // returns true if a process in the file did not pass error checking
+  bool failed();
+
+  void close();
+
+ private:
+  // points token at the next whitespace separated token, returns false if the file is exhausted
+  // token points into buffer, or into carry if it straddled two chunks, so it is only valid until the next call
+  bool nextToken(string_view &token);
+
+  // refills buffer from the file, returns false if there was nothing left to read
+  // a read error other than an interrupted read fails the loader, so a trace is never cut short without an error
+  bool fillBuffer();
+
+  int fd;
+  string fileName;
+  char *buffer;
+  size_t bufferLength, bufferIndex;
+  bool error;
+  // token holds the look-ahead token left over from the previous process, if hasToken is true
+  bool hasToken;
+  string_view token;
+  string carry;
+  // the current process's addresses, kept between processes so that its capacity is only grown, never reallocated per process
+  vector<int64_t> addresses;
+};
+
+#endif // TRACE_LOADER_H
@@ -0,0 +1,82 @@
+// FILE: tracePipeline.cpp
+// A Bautista, B Franco, E Mora
+// OS, Fall 2023, Transy U
+//
+//	implementation of --pipeline
+//
+//	head and tail count every slot ever consumed and filled, so the ring is empty when they are equal and full when they are
+//	PIPELINE_SLOTS apart, and slot index % PIPELINE_SLOTS is the one either of them refers to
+//	The slot nextProcess hands back is only given back to the parser on the following call, once the pager is done with its addresses
+//	The parser sets finished after its last fill, so once the pager sees finished an empty ring stays empty
+//
+
+#include "tracePipeline.h"
+#include <iostream>
+
+using namespace std;
+
+// checks again straight away PIPELINE_SPINS times, after that yields before each check
+static void backOff(int &spins){
+  if(++spins > PIPELINE_SPINS) this_thread::yield();
+}
+
+TracePipeline::TracePipeline(TraceLoader &loader, int pageSize, long long pages)
+  : loader(loader), slots(PIPELINE_SLOTS), head(0), tail(0), finished(false), stopping(false), original(NULL), outputBuffer(cout.rdbuf()){
+  this->pageSize = pageSize;
+  this->pages = pages;
+  holding = false;
+  if(!dynamic_cast<ThreadOutputBuffer *>(cout.rdbuf())){
+    cout.flush();
+    original = cout.rdbuf(&outputBuffer);
+  }
+  parser = thread(&TracePipeline::parse, this);
+}
+
+TracePipeline::~TracePipeline(){
+  stop();
+  if(original) cout.rdbuf(original);
+}
+
+void TracePipeline::stop(){
+  if(!parser.joinable()) return;
+  stopping.store(true, memory_order_release);
+  parser.join();
+}
+
+void TracePipeline::parse(){
+  ThreadOutputBuffer::capture(&errors);
+  while(true){
+    size_t index = tail.load(memory_order_relaxed);
+    int spins = 0;
+    while(index - head.load(memory_order_acquire) == slots.size() && !stopping.load(memory_order_acquire)) backOff(spins);
+    if(stopping.load(memory_order_acquire)) break;
+
+    PipelineSlot &slot = slots[index % slots.size()];
+    if(!loader.nextProcess(slot.block, pageSize, pages, slot.addresses)) break;
+    tail.store(index + 1, memory_order_release);
+  }
+  ThreadOutputBuffer::capture(NULL);
+  finished.store(true, memory_order_release);
+}
+
+bool TracePipeline::nextProcess(PCB &block){
+  size_t index = head.load(memory_order_relaxed);
+  if(holding){
+    head.store(++index, memory_order_release);
+    holding = false;
+  }
+
+  int spins = 0;
+  while(tail.load(memory_order_acquire) == index){
+    if(finished.load(memory_order_acquire) && tail.load(memory_order_acquire) == index){
+      stop();
+      cout << errors;
+      errors.clear();
+      return false;
+    }
+    backOff(spins);
+  }
+  block = slots[index % slots.size()].block;
+  holding = true;
+  return true;
+}
@@ -0,0 +1,71 @@
+// FILE: tracePipeline.h
+// A Bautista, B Franco, E Mora
+// OS, Fall 2023, Transy U
+//
+//	interface for --pipeline, which parses a text input file on a thread of its own while the processes parsed before it are paged
+//	The parser thread is the only producer and the paging thread the only consumer of a ring of PIPELINE_SLOTS parsed processes,
+//	so the ring needs no lock, only an index for each side that just its own thread writes, published with release and read with acquire
+//	A full ring holds the parser back until the pager hands a slot back and an empty one holds the pager back until the parser
+//	fills one, so no more than PIPELINE_SLOTS processes are held at once, the same bounded memory as a run without --pipeline
+//	A slot keeps its address buffer from one process to the next, so once the slots have grown to the longest bursts parsing allocates nothing
+//
+
+#ifndef TRACE_PIPELINE_H
+#define TRACE_PIPELINE_H
+
+#include "babyOS.h"
+#include "pagerPool.h"
+#include "traceLoader.h"
+#include <atomic>
+#include <stdint.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+// number of parsed processes the parser may get ahead of the pager by
+#define PIPELINE_SLOTS 16
+// number of times a side that has to wait checks the ring again before it yields its core to the other side
+#define PIPELINE_SPINS 64
+
+struct PipelineSlot{
+  PCB block;
+  vector<int64_t> addresses;
+};
+
+class TracePipeline{
+ public:
+  // starts parsing loader's processes on the parser thread, error checking their addresses against pages of size pageSize
+  // the loader belongs to the parser thread until nextProcess has returned false
+  TracePipeline(TraceLoader &loader, int pageSize, long long pages);
+  // stops the parser thread if it is still running
+  ~TracePipeline();
+
+  // waits for the next parsed process and hands it back in block, its addresses are only valid until the next call
+  // returns false once every process has been handed back or the loader found an error, which is printed then, after the
+  // output of the processes before it, where a run without --pipeline would have printed it
+  bool nextProcess(PCB &block);
+
+ private:
+  void parse();
+  void stop();
+
+  TraceLoader &loader;
+  int pageSize;
+  long long pages;
+  vector<PipelineSlot> slots;
+  // written only by the consumer and only by the parser, on cache lines of their own so that neither side's writes slow the other's reads
+  alignas(64) atomic<size_t> head;
+  alignas(64) atomic<size_t> tail;
+  alignas(64) atomic<bool> finished, stopping;
+  bool holding;
+  // the loader's errors, which it prints to cout, are captured here on the parser thread through a ThreadOutputBuffer
+  // cout's buffer is only swapped for outputBuffer if a PagerPool hasn't already swapped it for its own
+  string errors;
+  streambuf *original;
+  ThreadOutputBuffer outputBuffer;
+  thread parser;
+};
+
+#endif // TRACE_PIPELINE_H
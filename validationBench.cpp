@@ -0,0 +1,172 @@
+// FILE: validationBench.cpp
+// A Bautista, B Franco, E Mora
+// OS, Fall 2023, Transy U
+//
+//	microbenchmark comparing the string based error checks that babyOS used to validate every address and process header
+//	against the addressErrorCheck, idErrorCheck, and loadErrorCheck that ship in inputParse.cpp on the string_view/from_chars layer
+//
+//	To use validationBench enter the number of addresses to validate, otherwise BENCH_ADDRESSES is used
+//	ex. ./validationBench 10000000
+//	Both paths validate the same generated addresses, checked against DEFAULT_PAGES pages of DEFAULT_SIZE bytes, and the
+//	headers of one process for every BENCH_BURST of them, and sum the parsed values so the work can't be optimized away
+//
+
+#include "babyOS.h"
+#include "inputParse.h"
+#include <iostream>
+#include <cstring>
+#include <stdlib.h>
+#include <chrono>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+#define BENCH_ADDRESSES 10000000
+#define BENCH_SEED 3
+#define BENCH_BURST 100
+
+// the validation path as it was before inputParse.h, kept word for word so it can be compared against
+// except for integerCheck's loop index, which is now unsigned to match the length it is compared with
+bool legacyIntegerCheck(string integerString){
+  int integer = atoi(integerString.c_str());
+  string comparisonString, zeros = "";
+
+  for(size_t i=0;i<integerString.length();i++){
+    if(integerString[i]=='0'){
+      zeros += integerString[i];
+    }
+    else{
+      i=integerString.length();
+    }
+  }
+  comparisonString = zeros + to_string(integer);
+  if(!strcmp(zeros.c_str(),integerString.c_str()) || !strcmp(comparisonString.c_str(),integerString.c_str())) return true;
+  return false;
+}
+
+bool legacyAddressErrorCheck(int pid,int pageSize, int pages, string address){
+  if(!legacyIntegerCheck(address)){
+    cout << "\tERROR: Address " << address << " of " << PID_FORM << pid << " must be a non-negative integer\n";
+    return true;
+  }
+  else if((atoi(address.c_str())/pageSize) >= pages){
+    cout << "\tERROR: Address " << address << " of " << PID_FORM << pid << " cannot exist within " << pages << " " << pageSize << " byte pages\n";
+    return true;
+  }
+  return false;
+}
+
+bool legacyLoadErrorCheck(int pid, string arrival, string burst, string priority){
+  bool error = false;
+  if(!legacyIntegerCheck(arrival) || atoi(arrival.c_str()) < 0){
+    cout << "\tERROR: Arrival time of " << PID_FORM << pid << " must be a non-negative integer\n";
+    error = true;
+  }
+  if(!legacyIntegerCheck(burst) || atoi(burst.c_str()) <= 0){
+    cout << "\tERROR: CPU burst of " << PID_FORM << pid << " must be a non-negative integer\n";
+    error = true;
+  }
+  if(!legacyIntegerCheck(priority) || (atoi(priority.c_str()) > MAX_PRIORITY || atoi(priority.c_str()) < MIN_PRIORITY)){
+    cout << "\tERROR: Priority of " << PID_FORM << pid << " must be an integer from " << MIN_PRIORITY << " to " << MAX_PRIORITY << "\n";
+    error = true;
+  }
+  return error;
+}
+
+bool legacyIdErrorCheck(string fileInput){
+  bool error = false;
+  if(fileInput.find(PID_FORM) != 0 || fileInput.length() < 3){
+    cout << "\tERROR: Process id " << fileInput << " is not of form " << PID_FORM << "#\n";
+    error = true;
+  }
+  else if(!legacyIntegerCheck(fileInput.substr(2,fileInput.length()).c_str()) || atoi(fileInput.substr(2,fileInput.length()).c_str()) < 0){
+    cout << "\tERROR: Process id " << fileInput << " must be a non-negative integer\n";
+    error = true;
+  }
+  return error;
+}
+
+// splits text into its whitespace separated tokens
+static vector<string_view> tokenize(const string &text){
+  vector<string_view> tokens;
+  size_t start = 0, end;
+  while((start = text.find_first_not_of(" \n", start)) != string::npos){
+    end = text.find_first_of(" \n", start);
+    if(end == string::npos) end = text.size();
+    tokens.push_back(string_view(text.data() + start, end - start));
+    start = end;
+  }
+  return tokens;
+}
+
+static void printRow(const char *name, long count, chrono::duration<double> legacyTime, chrono::duration<double> shippedTime){
+  cout << "\t" << name << ": legacy " << legacyTime.count() << " s (" << count / legacyTime.count() << "/s), shipped "
+       << shippedTime.count() << " s (" << count / shippedTime.count() << "/s), speedup " << legacyTime.count() / shippedTime.count() << "x\n";
+}
+
+int main(int argc, char **argv){
+  long count = BENCH_ADDRESSES, processes;
+  int pageSize = atoi(DEFAULT_SIZE), pages = atoi(DEFAULT_PAGES);
+  if(argc > 1) count = atol(argv[1]);
+  if(count <= 0){
+    cout << "\tERROR: Number of addresses must be a positive integer\n";
+    exit(1);
+  }
+  processes = count / BENCH_BURST + 1;
+
+  // builds the addresses and process headers as whitespace separated text the way they appear in an input file, some with prepended zeros
+  string addressText, headerText;
+  srand(BENCH_SEED);
+  for(long i = 0; i < count; i++){
+    if(rand() % 8 == 0) addressText += "000";
+    addressText += to_string(rand() % (pageSize * pages));
+    addressText += '\n';
+  }
+  for(long i = 0; i < processes; i++){
+    headerText += PID_FORM + to_string(i) + " " + to_string(rand() % 1000) + " " + to_string(BENCH_BURST) + " " +
+                  to_string(MIN_PRIORITY + rand() % (MAX_PRIORITY - MIN_PRIORITY + 1)) + "\n";
+  }
+  vector<string_view> addresses = tokenize(addressText), headers = tokenize(headerText);
+
+  // the legacy loader held each token in a string and passed it by value, so the copy is part of what is timed
+  // the sums keep the work from being optimized away and must match
+  long long legacySum = 0, shippedSum = 0, value;
+  chrono::steady_clock::time_point start = chrono::steady_clock::now();
+  for(long i = 0; i < count; i++){
+    string token(addresses[i]);
+    if(legacyAddressErrorCheck(0,pageSize,pages,token)) exit(1);
+    legacySum += atoi(token.c_str());
+  }
+  chrono::duration<double> legacyAddressTime = chrono::steady_clock::now() - start;
+  start = chrono::steady_clock::now();
+  for(long i = 0; i < count; i++){
+    if(addressErrorCheck(0,pageSize,pages,addresses[i],value)) exit(1);
+    shippedSum += value;
+  }
+  chrono::duration<double> shippedAddressTime = chrono::steady_clock::now() - start;
+
+  PCB block;
+  start = chrono::steady_clock::now();
+  for(long i = 0; i < processes; i++){
+    string id(headers[4 * i]), arrival(headers[4 * i + 1]), burst(headers[4 * i + 2]), priority(headers[4 * i + 3]);
+    if(legacyIdErrorCheck(id) || legacyLoadErrorCheck(i,arrival,burst,priority)) exit(1);
+    legacySum += atoi(id.c_str() + 2) + atoi(arrival.c_str()) + atoi(burst.c_str()) + atoi(priority.c_str());
+  }
+  chrono::duration<double> legacyHeaderTime = chrono::steady_clock::now() - start;
+  start = chrono::steady_clock::now();
+  for(long i = 0; i < processes; i++){
+    if(idErrorCheck(headers[4 * i], block.pid) || loadErrorCheck(block.pid,headers[4 * i + 1],headers[4 * i + 2],headers[4 * i + 3],block)) exit(1);
+    shippedSum += block.pid + block.arrival + block.burst + block.priority;
+  }
+  chrono::duration<double> shippedHeaderTime = chrono::steady_clock::now() - start;
+
+  if(legacySum != shippedSum){
+    cout << "\tERROR: Validation paths disagree (" << legacySum << " vs " << shippedSum << ")\n";
+    exit(1);
+  }
+  cout << "Validated " << count << " addresses and " << processes << " process headers\n";
+  printRow("addressErrorCheck", count, legacyAddressTime, shippedAddressTime);
+  printRow("idErrorCheck and loadErrorCheck", processes, legacyHeaderTime, shippedHeaderTime);
+  return 0;
+}